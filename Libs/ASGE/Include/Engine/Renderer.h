@@ -35,7 +35,8 @@ namespace ASGE {
 			INVALID = -1,     /**< Invalid engine. There is a serious issue here. */
 			PDCURSES = 0,     /**< PDCurses for unix. An ASCII only renderer. */
 			PDCURSES_W32 = 1, /**< PDCurses for w32. An ASCII only renderer. */
-			GLEW = 2          /**< GLEW. An OpenGL library. */
+			GLEW = 2,         /**< GLEW. An OpenGL library. */
+			SOFTWARE = 3      /**< Software. A CPU only renderer that draws into memory. */
 		}; RenderLib getRenderLibrary() noexcept;  
 
 		/**
@@ -1,7 +1,7 @@
 #pragma once
 #include <memory>
 #include <string>
-#include <Engine\Colours.h>
+#include <Engine/Colours.h>
 
 namespace ASGE {
 	class Renderer;
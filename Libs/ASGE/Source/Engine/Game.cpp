@@ -0,0 +1,89 @@
+#include <cstdlib>
+#include <string>
+#include <Engine/Game.h>
+
+namespace ASGE {
+
+	namespace
+	{
+		/**
+		*  FPS sampling. Kept out of Game so its layout matches the
+		*  prebuilt engine.
+		*/
+		std::chrono::steady_clock::time_point fps_start;
+		int fps_frames = 0;
+		int fps = 0;
+	}
+
+	/**
+	*  The main loop.
+	*  Setting ASGE_FIXED_DELTA_MS makes every frame report the same
+	*  delta, so headless runs behave the same on any machine.
+	*/
+	int Game::run()
+	{
+		const char* fixed = std::getenv("ASGE_FIXED_DELTA_MS");
+		const double fixed_delta = fixed ? std::atof(fixed) : 0.0;
+		const auto start = std::chrono::steady_clock::now();
+		us.frame_time = start;
+		fps_start = start;
+
+		while (!exit)
+		{
+			const auto now = std::chrono::steady_clock::now();
+			if (fixed_delta > 0.0)
+			{
+				us.delta_time = std::chrono::duration<double, std::milli>(fixed_delta);
+				us.game_time += std::chrono::milliseconds(static_cast<long long>(fixed_delta));
+			}
+			else
+			{
+				us.delta_time = now - us.frame_time;
+				us.game_time = std::chrono::duration_cast<std::chrono::milliseconds>(now - start);
+			}
+			us.frame_time = now;
+
+			inputs->update();
+			beginFrame();
+			update(us);
+			render(us);
+			endFrame();
+		}
+
+		return exitAPI() ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	void Game::signalExit() noexcept
+	{
+		exit = true;
+	}
+
+	void Game::toggleFPS() noexcept
+	{
+		show_fps = !show_fps;
+	}
+
+	/**
+	*  Counts the frame and draws the frames in the last second.
+	*  Drawn at the highest z order so it is never hidden.
+	*/
+	void Game::updateFPS()
+	{
+		fps_frames++;
+		const auto now = std::chrono::steady_clock::now();
+		if (now - fps_start >= std::chrono::seconds(1))
+		{
+			fps = fps_frames;
+			fps_frames = 0;
+			fps_start = now;
+		}
+
+		renderer->renderText("FPS: " + std::to_string(fps), 10, 20, 1.0f, COLOURS::YELLOWGREEN, 1000.0f);
+	}
+
+	std::chrono::milliseconds Game::getGameTime() noexcept
+	{
+		return std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::steady_clock::now().time_since_epoch());
+	}
+}
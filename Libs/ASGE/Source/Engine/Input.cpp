@@ -0,0 +1,266 @@
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <Engine/Input.h>
+
+namespace ASGE {
+
+	namespace
+	{
+		/**
+		*  A copy of one event of any type.
+		*/
+		struct EventStore
+		{
+			KeyEvent key;
+			ClickEvent click;
+			ScrollEvent scroll;
+			MoveEvent move;
+			GamePadEvent gamepad;
+		};
+
+		/**
+		*  A queued event. Its store is allocated once and reused, and
+		*  callbacks are handed pointers into it that share its count.
+		*/
+		struct Slot
+		{
+			EventType type = E_KEY;
+			std::shared_ptr<EventStore> store = std::make_shared<EventStore>();
+		};
+
+		/**
+		*  The thread an input handler's events are delivered on when
+		*  use_threads is set. One thread per handler delivers events in
+		*  the order they were sent, so callbacks see a single producer.
+		*  Events are copied into a fixed ring of slots, so sending
+		*  allocates nothing and the sender's event is free to reuse as
+		*  soon as it returns. A sender finding the ring full waits for
+		*  the dispatcher to catch up.
+		*/
+		struct Dispatcher
+		{
+			static const size_t CAPACITY = 64;
+			std::mutex lock;
+			std::condition_variable wake;
+			std::condition_variable space;
+			std::condition_variable idle;
+			Slot slots[CAPACITY];
+			size_t head = 0;
+			size_t tail = 0;
+			bool delivering = false;
+			bool stopping = false;
+			std::thread thread;
+		};
+
+		/**
+		*  Copies an event into a slot's store.
+		*/
+		void copyEvent(Slot& slot, EventType type, const EventData& data)
+		{
+			slot.type = type;
+			switch (type)
+			{
+			case E_KEY:            slot.store->key = static_cast<const KeyEvent&>(data); break;
+			case E_MOUSE_CLICK:    slot.store->click = static_cast<const ClickEvent&>(data); break;
+			case E_MOUSE_SCROLL:   slot.store->scroll = static_cast<const ScrollEvent&>(data); break;
+			case E_MOUSE_MOVE:     slot.store->move = static_cast<const MoveEvent&>(data); break;
+			case E_GAMEPAD_STATUS: slot.store->gamepad = static_cast<const GamePadEvent&>(data); break;
+			}
+		}
+
+		/**
+		*  Points at the event in a slot's store without allocating.
+		*/
+		SharedEventData eventIn(const Slot& slot)
+		{
+			const EventStore* store = slot.store.get();
+			switch (slot.type)
+			{
+			case E_MOUSE_CLICK:    return SharedEventData(slot.store, &store->click);
+			case E_MOUSE_SCROLL:   return SharedEventData(slot.store, &store->scroll);
+			case E_MOUSE_MOVE:     return SharedEventData(slot.store, &store->move);
+			case E_GAMEPAD_STATUS: return SharedEventData(slot.store, &store->gamepad);
+			default:               return SharedEventData(slot.store, &store->key);
+			}
+		}
+
+		/**
+		*  Dispatchers per input handler.
+		*  Kept out of Input so its layout matches the prebuilt engine.
+		*/
+		std::mutex dispatchers_lock;
+		std::unordered_map<const Input*, std::unique_ptr<Dispatcher>> dispatchers;
+
+		Dispatcher* find(const Input* input)
+		{
+			std::lock_guard<std::mutex> guard(dispatchers_lock);
+			auto found = dispatchers.find(input);
+			return found == dispatchers.end() ? nullptr : found->second.get();
+		}
+
+		/**
+		*  Waits until every event sent so far has been delivered, so the
+		*  callbacks can be changed without racing the dispatcher.
+		*/
+		void waitIdle(const Input* input)
+		{
+			Dispatcher* dispatcher = find(input);
+			if (dispatcher)
+			{
+				std::unique_lock<std::mutex> guard(dispatcher->lock);
+				dispatcher->idle.wait(guard, [dispatcher]()
+				{
+					return dispatcher->head == dispatcher->tail && !dispatcher->delivering;
+				});
+			}
+		}
+	}
+
+	Input::Input() = default;
+
+	/**
+	*  Delivers any threaded events and stops the dispatcher before the
+	*  callbacks go away.
+	*/
+	Input::~Input()
+	{
+		std::unique_ptr<Dispatcher> dispatcher;
+		{
+			std::lock_guard<std::mutex> guard(dispatchers_lock);
+			auto found = dispatchers.find(this);
+			if (found != dispatchers.end())
+			{
+				dispatcher = std::move(found->second);
+				dispatchers.erase(found);
+			}
+		}
+
+		if (dispatcher)
+		{
+			{
+				std::lock_guard<std::mutex> guard(dispatcher->lock);
+				dispatcher->stopping = true;
+			}
+			dispatcher->wake.notify_one();
+			dispatcher->thread.join();
+		}
+
+		callback_funcs.clear();
+	}
+
+	/**
+	*  Forwards an event to every callback listening for its type.
+	*  With use_threads set, the event is copied for the handler's
+	*  dispatcher thread, which is started on the first event.
+	*/
+	void Input::sendEvent(EventType type, SharedEventData data)
+	{
+		if (!use_threads)
+		{
+			for (const auto& callback : callback_funcs)
+			{
+				if (callback.first == type && callback.second)
+				{
+					callback.second(data);
+				}
+			}
+			return;
+		}
+
+		Dispatcher* dispatcher = nullptr;
+		{
+			std::lock_guard<std::mutex> guard(dispatchers_lock);
+			auto& slot = dispatchers[this];
+			if (!slot)
+			{
+				slot.reset(new Dispatcher);
+				Dispatcher* started = slot.get();
+				started->thread = std::thread([this, started]()
+				{
+					std::unique_lock<std::mutex> guard(started->lock);
+					while (true)
+					{
+						started->wake.wait(guard, [started]()
+						{
+							return started->stopping || started->head != started->tail;
+						});
+
+						if (started->head == started->tail)
+						{
+							return;
+						}
+
+						//the sender never writes a slot until head has passed it
+						Slot& slot = started->slots[started->head % Dispatcher::CAPACITY];
+						started->delivering = true;
+						guard.unlock();
+
+						{
+							const SharedEventData event = eventIn(slot);
+							for (const auto& callback : callback_funcs)
+							{
+								if (callback.first == slot.type && callback.second)
+								{
+									callback.second(event);
+								}
+							}
+						}
+
+						//a callback kept the event, so the slot needs a new store
+						if (slot.store.use_count() > 1)
+						{
+							slot.store = std::make_shared<EventStore>();
+						}
+
+						guard.lock();
+						started->head++;
+						started->delivering = false;
+						started->space.notify_one();
+						if (started->head == started->tail)
+						{
+							started->idle.notify_all();
+						}
+					}
+				});
+			}
+			dispatcher = slot.get();
+		}
+
+		{
+			std::unique_lock<std::mutex> guard(dispatcher->lock);
+			dispatcher->space.wait(guard, [dispatcher]()
+			{
+				return dispatcher->tail - dispatcher->head < Dispatcher::CAPACITY;
+			});
+
+			copyEvent(dispatcher->slots[dispatcher->tail % Dispatcher::CAPACITY], type, *data);
+			dispatcher->tail++;
+		}
+		dispatcher->wake.notify_one();
+	}
+
+	/**
+	*  Callbacks are identified by their slot, so removed callbacks are
+	*  emptied rather than erased to keep the other handles valid.
+	*/
+	void Input::unregisterCallback(unsigned int id)
+	{
+		waitIdle(this);
+		if (id < callback_funcs.size())
+		{
+			callback_funcs[id].second = nullptr;
+		}
+	}
+
+	int Input::registerCallback(EventType type, InputFnc fnc)
+	{
+		waitIdle(this);
+		callback_funcs.push_back(InputFncPair(type, fnc));
+		return static_cast<int>(callback_funcs.size()) - 1;
+	}
+}
@@ -0,0 +1,34 @@
+#include <Engine/Renderer.h>
+
+namespace ASGE {
+
+	Renderer::RenderLib Renderer::getRenderLibrary() noexcept
+	{
+		return lib;
+	}
+
+	Renderer::WindowMode Renderer::getWindowMode() noexcept
+	{
+		return window_mode;
+	}
+
+	void Renderer::renderText(const std::string str, int x, int y, float scale, const Colour& colour)
+	{
+		renderText(str, x, y, scale, colour, 0.0f);
+	}
+
+	void Renderer::renderText(const std::string str, int x, int y, const Colour& colour)
+	{
+		renderText(str, x, y, 1.0f, colour, 0.0f);
+	}
+
+	void Renderer::renderText(const std::string str, int x, int y)
+	{
+		renderText(str, x, y, 1.0f, default_text_colour, 0.0f);
+	}
+
+	void Renderer::renderSprite(const Sprite& sprite)
+	{
+		renderSprite(sprite, 0.0f);
+	}
+}
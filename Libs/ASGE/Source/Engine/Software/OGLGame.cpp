@@ -0,0 +1,159 @@
+#include <cstdio>
+#include <cstdlib>
+#include <Engine/OGLGame.h>
+#include "SWInput.h"
+#include "SWRenderer.h"
+
+namespace ASGE {
+
+	/**
+	*  Headless builds back OGLGame with the software renderer.
+	*  The run can be controlled through the environment:
+	*  ASGE_HEADLESS_FRAMES exits after that many frames,
+	*  ASGE_HEADLESS_DUMP names a directory every nth frame is written
+	*  to, n being ASGE_HEADLESS_DUMP_EVERY, and ASGE_HEADLESS_INPUT
+	*  names a file of input to send, see InputScript.
+	*/
+	namespace
+	{
+		unsigned int frame_limit = 0;
+
+		/**
+		*  Input read from a file and sent as the frames go by.
+		*  Each line is a frame number followed by one event, sent once
+		*  that frame has been drawn: "m <x> <y>" moves the cursor,
+		*  "c <button> <action>" clicks and "k <key> <action>" presses a
+		*  key, actions being KEYS::KEY_PRESSED or KEYS::KEY_RELEASED.
+		*  Lines starting with # are comments.
+		*/
+		class InputScript
+		{
+		public:
+			~InputScript()
+			{
+				close();
+			}
+
+			bool open(const char* file_name)
+			{
+				file = std::fopen(file_name, "r");
+				return file != nullptr;
+			}
+
+			void play(SWInput& input, unsigned int frame)
+			{
+				while (file && (pending || read()) && next.frame <= frame)
+				{
+					pending = false;
+					switch (next.op)
+					{
+					case 'm': input.moveCursor(next.a, next.b); break;
+					case 'c': input.click(static_cast<int>(next.a), static_cast<int>(next.b)); break;
+					case 'k': input.key(static_cast<int>(next.a), static_cast<int>(next.b)); break;
+					}
+				}
+			}
+
+		private:
+			struct Event
+			{
+				unsigned int frame = 0;
+				char op = 0;
+				double a = 0;
+				double b = 0;
+			};
+
+			bool read()
+			{
+				char line[128];
+				while (std::fgets(line, sizeof(line), file))
+				{
+					if (line[0] != '#' &&
+						std::sscanf(line, "%u %c %lf %lf", &next.frame, &next.op, &next.a, &next.b) == 4)
+					{
+						pending = true;
+						return true;
+					}
+				}
+
+				close();
+				return false;
+			}
+
+			void close()
+			{
+				if (file)
+				{
+					std::fclose(file);
+					file = nullptr;
+				}
+			}
+
+			std::FILE* file = nullptr;
+			Event next;
+			bool pending = false;
+		};
+
+		InputScript input_script;
+
+		unsigned int readUnsigned(const char* name, unsigned int fallback)
+		{
+			const char* value = std::getenv(name);
+			return value ? static_cast<unsigned int>(std::strtoul(value, nullptr, 10)) : fallback;
+		}
+	}
+
+	bool OGLGame::initAPI(Renderer::WindowMode mode)
+	{
+		auto software = std::unique_ptr<SWRenderer>(new SWRenderer());
+		if (!software->init(game_width, game_height, mode))
+		{
+			return false;
+		}
+
+		const char* dump = std::getenv("ASGE_HEADLESS_DUMP");
+		if (dump && *dump)
+		{
+			software->dumpFrames(dump, readUnsigned("ASGE_HEADLESS_DUMP_EVERY", 1));
+		}
+		frame_limit = readUnsigned("ASGE_HEADLESS_FRAMES", 0);
+
+		const char* input = std::getenv("ASGE_HEADLESS_INPUT");
+		if (input && *input && !input_script.open(input))
+		{
+			return false;
+		}
+
+		renderer = std::move(software);
+		inputs = renderer->inputPtr();
+		return inputs->init(renderer.get());
+	}
+
+	bool OGLGame::exitAPI() noexcept
+	{
+		return renderer ? renderer->exit() : true;
+	}
+
+	void OGLGame::beginFrame()
+	{
+		renderer->preRender();
+	}
+
+	void OGLGame::endFrame()
+	{
+		if (show_fps)
+		{
+			updateFPS();
+		}
+
+		renderer->postRender();
+		renderer->swapBuffers();
+
+		auto software = static_cast<SWRenderer*>(renderer.get());
+		input_script.play(*static_cast<SWInput*>(inputs.get()), software->frameCount());
+		if (frame_limit && software->frameCount() >= frame_limit)
+		{
+			signalExit();
+		}
+	}
+}
@@ -0,0 +1,134 @@
+#include "SWBlend.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ASGE_SW_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace ASGE {
+	namespace SWBlend {
+
+#ifdef ASGE_SW_SSE2
+		namespace
+		{
+			/**
+			*  Multiplies 16 bit channels by 16 bit factors and divides
+			*  by 255 with rounding, exactly.
+			*/
+			inline __m128i mulDiv255(__m128i value, __m128i factor)
+			{
+				__m128i product = _mm_add_epi16(
+					_mm_mullo_epi16(value, factor), _mm_set1_epi16(128));
+				return _mm_srli_epi16(
+					_mm_add_epi16(product, _mm_srli_epi16(product, 8)), 8);
+			}
+
+			inline __m128i inverseAlpha(__m128i pixels16)
+			{
+				__m128i alpha = _mm_shufflelo_epi16(pixels16, _MM_SHUFFLE(3, 3, 3, 3));
+				alpha = _mm_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+				return _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+			}
+		}
+#endif
+
+		void blendRow(uint32_t* dst, const uint32_t* src, int count) noexcept
+		{
+			int i = 0;
+
+#ifdef ASGE_SW_SSE2
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i alpha_mask = _mm_set1_epi32(static_cast<int>(0xFF000000));
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+				__m128i alpha = _mm_and_si128(s, alpha_mask);
+
+				//fully transparent, nothing to do
+				if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, zero)) == 0xFFFF)
+				{
+					continue;
+				}
+
+				//fully opaque, straight copy
+				if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, alpha_mask)) == 0xFFFF)
+				{
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), s);
+					continue;
+				}
+
+				__m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+				__m128i d_lo = _mm_unpacklo_epi8(d, zero);
+				__m128i d_hi = _mm_unpackhi_epi8(d, zero);
+				__m128i inv_lo = inverseAlpha(_mm_unpacklo_epi8(s, zero));
+				__m128i inv_hi = inverseAlpha(_mm_unpackhi_epi8(s, zero));
+
+				__m128i result = _mm_packus_epi16(
+					mulDiv255(d_lo, inv_lo), mulDiv255(d_hi, inv_hi));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+					_mm_adds_epu8(result, s));
+			}
+#endif
+
+			for (; i < count; i++)
+			{
+				const uint32_t a = src[i] >> 24;
+				if (a == 255)
+				{
+					dst[i] = src[i];
+				}
+				else if (a)
+				{
+					dst[i] = blendPixel(dst[i], src[i]);
+				}
+			}
+		}
+
+		void modulateRow(uint32_t* row, int count, const uint16_t factors[4]) noexcept
+		{
+			int i = 0;
+
+#ifdef ASGE_SW_SSE2
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i factor = _mm_set_epi16(
+				factors[3], factors[2], factors[1], factors[0],
+				factors[3], factors[2], factors[1], factors[0]);
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+				__m128i lo = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(p, zero), factor), 8);
+				__m128i hi = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(p, zero), factor), 8);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(row + i), _mm_packus_epi16(lo, hi));
+			}
+#endif
+
+			for (; i < count; i++)
+			{
+				const uint32_t p = row[i];
+				const uint32_t r = ((p & 0xFF) * factors[0]) >> 8;
+				const uint32_t g = (((p >> 8) & 0xFF) * factors[1]) >> 8;
+				const uint32_t b = (((p >> 16) & 0xFF) * factors[2]) >> 8;
+				const uint32_t a = ((p >> 24) * factors[3]) >> 8;
+				row[i] = r | (g << 8) | (b << 16) | (a << 24);
+			}
+		}
+
+		void fillRow(uint32_t* dst, uint32_t colour, int count) noexcept
+		{
+			int i = 0;
+
+#ifdef ASGE_SW_SSE2
+			const __m128i value = _mm_set1_epi32(static_cast<int>(colour));
+			for (; i + 4 <= count; i += 4)
+			{
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), value);
+			}
+#endif
+
+			for (; i < count; i++)
+			{
+				dst[i] = colour;
+			}
+		}
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+
+namespace ASGE {
+
+	/**
+	*  Pixel kernels used by the software renderer.
+	*  All pixels are 32 bit RGBA with premultiplied alpha. Each kernel
+	*  has an SSE2 implementation working on four pixels at a time and a
+	*  scalar fallback for other targets and the ends of rows.
+	*/
+	namespace SWBlend
+	{
+		/**
+		*  Source-over blends a row of pixels onto the destination.
+		*  dst = src + dst * (1 - src.a)
+		*/
+		void blendRow(uint32_t* dst, const uint32_t* src, int count) noexcept;
+
+		/**
+		*  Scales every channel of a row by a factor out of 256.
+		*  Used to apply a sprite's tint and opacity.
+		*  @param [in] factors The r, g, b and a factors, 0 to 256.
+		*/
+		void modulateRow(uint32_t* row, int count, const uint16_t factors[4]) noexcept;
+
+		/**
+		*  Fills a row with a single colour.
+		*/
+		void fillRow(uint32_t* dst, uint32_t colour, int count) noexcept;
+
+		/**
+		*  Blends a single pixel.
+		*/
+		inline uint32_t blendPixel(uint32_t dst, uint32_t src) noexcept
+		{
+			const uint32_t inv = 255 - (src >> 24);
+			uint32_t rb = (dst & 0x00FF00FF) * inv + 0x00800080;
+			rb = ((rb + ((rb >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+			uint32_t ga = ((dst >> 8) & 0x00FF00FF) * inv + 0x00800080;
+			ga = (ga + ((ga >> 8) & 0x00FF00FF)) & 0xFF00FF00;
+			return src + (rb | ga);
+		}
+	}
+}
@@ -0,0 +1,114 @@
+#include <cctype>
+#include "SWFont.h"
+
+namespace ASGE {
+
+	namespace
+	{
+		struct GlyphRows
+		{
+			char character;
+			const char* rows[SWFont::GLYPH_HEIGHT];
+		};
+
+		const GlyphRows GLYPHS[] =
+		{
+			{ '0', { "111", "101", "101", "101", "111" } },
+			{ '1', { "010", "110", "010", "010", "111" } },
+			{ '2', { "111", "001", "111", "100", "111" } },
+			{ '3', { "111", "001", "111", "001", "111" } },
+			{ '4', { "101", "101", "111", "001", "001" } },
+			{ '5', { "111", "100", "111", "001", "111" } },
+			{ '6', { "111", "100", "111", "101", "111" } },
+			{ '7', { "111", "001", "010", "010", "010" } },
+			{ '8', { "111", "101", "111", "101", "111" } },
+			{ '9', { "111", "101", "111", "001", "111" } },
+			{ 'A', { "010", "101", "111", "101", "101" } },
+			{ 'B', { "110", "101", "110", "101", "110" } },
+			{ 'C', { "011", "100", "100", "100", "011" } },
+			{ 'D', { "110", "101", "101", "101", "110" } },
+			{ 'E', { "111", "100", "110", "100", "111" } },
+			{ 'F', { "111", "100", "110", "100", "100" } },
+			{ 'G', { "011", "100", "101", "101", "011" } },
+			{ 'H', { "101", "101", "111", "101", "101" } },
+			{ 'I', { "111", "010", "010", "010", "111" } },
+			{ 'J', { "001", "001", "001", "101", "010" } },
+			{ 'K', { "101", "101", "110", "101", "101" } },
+			{ 'L', { "100", "100", "100", "100", "111" } },
+			{ 'M', { "101", "111", "111", "101", "101" } },
+			{ 'N', { "110", "101", "101", "101", "101" } },
+			{ 'O', { "010", "101", "101", "101", "010" } },
+			{ 'P', { "110", "101", "110", "100", "100" } },
+			{ 'Q', { "010", "101", "101", "110", "011" } },
+			{ 'R', { "110", "101", "110", "101", "101" } },
+			{ 'S', { "011", "100", "010", "001", "110" } },
+			{ 'T', { "111", "010", "010", "010", "010" } },
+			{ 'U', { "101", "101", "101", "101", "111" } },
+			{ 'V', { "101", "101", "101", "101", "010" } },
+			{ 'W', { "101", "101", "111", "111", "101" } },
+			{ 'X', { "101", "101", "010", "101", "101" } },
+			{ 'Y', { "101", "101", "010", "010", "010" } },
+			{ 'Z', { "111", "001", "010", "100", "111" } },
+			{ ':', { "000", "010", "000", "010", "000" } },
+			{ '.', { "000", "000", "000", "000", "010" } },
+			{ ',', { "000", "000", "000", "010", "100" } },
+			{ '-', { "000", "000", "111", "000", "000" } },
+			{ '+', { "000", "010", "111", "010", "000" } },
+			{ '/', { "001", "001", "010", "100", "100" } },
+			{ '%', { "101", "001", "010", "100", "101" } },
+			{ '!', { "010", "010", "010", "000", "010" } },
+			{ '?', { "111", "001", "010", "000", "010" } },
+			{ '(', { "001", "010", "010", "010", "001" } },
+			{ ')', { "100", "010", "010", "010", "100" } },
+			{ '=', { "000", "111", "000", "111", "000" } },
+			{ '_', { "000", "000", "000", "000", "111" } },
+			{ '#', { "101", "111", "101", "111", "101" } },
+		};
+
+		/**
+		*  Builds the 128 entry lookup table from the readable rows.
+		*/
+		struct GlyphTable
+		{
+			uint16_t bits[128] = {};
+
+			GlyphTable() noexcept
+			{
+				for (const auto& glyph : GLYPHS)
+				{
+					uint16_t value = 0;
+					for (int row = 0; row < SWFont::GLYPH_HEIGHT; row++)
+					{
+						for (int col = 0; col < SWFont::GLYPH_WIDTH; col++)
+						{
+							value = static_cast<uint16_t>(value << 1);
+							value |= glyph.rows[row][col] == '1' ? 1 : 0;
+						}
+					}
+
+					bits[static_cast<unsigned char>(glyph.character)] = value;
+				}
+			}
+		};
+	}
+
+	SWFont::SWFont(const char* name, int size) noexcept
+	{
+		font_name = name;
+		font_size = size;
+		line_height = size + size / 4;
+	}
+
+	uint16_t SWFont::glyph(char character) noexcept
+	{
+		static const GlyphTable table;
+		const int upper = std::toupper(static_cast<unsigned char>(character));
+		return upper < 128 ? table.bits[upper] : 0;
+	}
+
+	int SWFont::pixelSize(float scale) const noexcept
+	{
+		const int size = static_cast<int>(font_size * scale / (GLYPH_HEIGHT + 2) + 0.5f);
+		return size < 1 ? 1 : size;
+	}
+}
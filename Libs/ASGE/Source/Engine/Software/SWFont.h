@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include <Engine/Font.h>
+
+namespace ASGE {
+
+	/**
+	*  The software renderer's built-in font.
+	*  A 3x5 pixel bitmap font covering digits, upper case letters and
+	*  common punctuation. Lower case is drawn as upper case. Glyphs are
+	*  scaled up by whole pixels to approximate the requested size.
+	*/
+	struct SWFont : public Font
+	{
+		SWFont(const char* name, int size) noexcept;
+
+		static constexpr int GLYPH_WIDTH = 3;
+		static constexpr int GLYPH_HEIGHT = 5;
+
+		/**
+		*  Returns a glyph's bitmap.
+		*  Bit 14 is the top left pixel, rows run top to bottom.
+		*  @param [in] character The character to look up.
+		*  @return The bitmap, 0 for characters without a glyph.
+		*/
+		static uint16_t glyph(char character) noexcept;
+
+		/**
+		*  Returns the size of a glyph pixel for a given text scale.
+		*/
+		int pixelSize(float scale) const noexcept;
+	};
+}
@@ -0,0 +1,77 @@
+#include "SWInput.h"
+
+namespace ASGE {
+
+	namespace
+	{
+		/**
+		*  Returns the event to fill, a new one only while a handler
+		*  on another thread still holds the last.
+		*/
+		template <typename T>
+		T& reuse(std::shared_ptr<T>& event)
+		{
+			if (!event || event.use_count() > 1)
+			{
+				event = std::make_shared<T>();
+			}
+
+			return *event;
+		}
+	}
+
+	bool SWInput::init(Renderer*)
+	{
+		return true;
+	}
+
+	void SWInput::update()
+	{
+	}
+
+	void SWInput::getCursorPos(double &xpos, double &ypos) const
+	{
+		xpos = cursor_x;
+		ypos = cursor_y;
+	}
+
+	void SWInput::setCursorMode(CursorMode mode)
+	{
+		cursor_mode = mode;
+	}
+
+	const GamePadData SWInput::getGamePad(int idx) const
+	{
+		return GamePadData(idx, "", 0, nullptr, 0, nullptr);
+	}
+
+	void SWInput::moveCursor(double xpos, double ypos)
+	{
+		cursor_x = xpos;
+		cursor_y = ypos;
+
+		MoveEvent& event = reuse(move_event);
+		event.xpos = xpos;
+		event.ypos = ypos;
+		sendEvent(E_MOUSE_MOVE, move_event);
+	}
+
+	void SWInput::click(int button, int action)
+	{
+		ClickEvent& event = reuse(click_event);
+		event.button = button;
+		event.action = action;
+		event.mods = 0;
+		sendEvent(E_MOUSE_CLICK, click_event);
+	}
+
+	void SWInput::key(int key, int action, int mods)
+	{
+		KeyEvent& event = reuse(key_event);
+		event.key = key;
+		event.scancode = key;
+		event.action = action;
+		event.mods = mods;
+		sendEvent(E_KEY, key_event);
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <Engine/Input.h>
+
+namespace ASGE {
+
+	/**
+	*  Input for the headless software renderer.
+	*  There is no window to poll, so events are injected instead. This
+	*  allows benchmarks and CI runs to script clicks and key presses.
+	*  Each kind of event is reused once its handlers have let go of it,
+	*  so scripted input does not allocate an event per call.
+	*/
+	class SWInput : public Input
+	{
+	public:
+		SWInput() = default;
+		virtual ~SWInput() = default;
+
+		virtual bool init(Renderer* renderer) override;
+		virtual void update() override;
+		virtual void getCursorPos(double &xpos, double &ypos) const override;
+		virtual void setCursorMode(CursorMode mode) override;
+		virtual const GamePadData getGamePad(int idx) const override;
+
+		/**
+		*  Moves the cursor and sends a mouse move event.
+		*/
+		void moveCursor(double xpos, double ypos);
+
+		/**
+		*  Sends a mouse click event.
+		*  @param [in] button The mouse button, 0 being left.
+		*  @param [in] action KEYS::KEY_PRESSED or KEYS::KEY_RELEASED.
+		*/
+		void click(int button, int action);
+
+		/**
+		*  Sends a key event.
+		*  @param [in] key The key, see KEYS.
+		*  @param [in] action KEYS::KEY_PRESSED or KEYS::KEY_RELEASED.
+		*  @param [in] mods Any modifiers.
+		*/
+		void key(int key, int action, int mods = 0);
+
+	private:
+		double cursor_x = 0;
+		double cursor_y = 0;
+		CursorMode cursor_mode = CursorMode::NORMAL;
+		std::shared_ptr<MoveEvent> move_event;
+		std::shared_ptr<ClickEvent> click_event;
+		std::shared_ptr<KeyEvent> key_event;
+	};
+}
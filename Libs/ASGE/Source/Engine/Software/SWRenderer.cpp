@@ -0,0 +1,543 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <png.h>
+
+#include <Engine/Sprite.h>
+#include "SWBlend.h"
+#include "SWInput.h"
+#include "SWRenderer.h"
+#include "SWSprite.h"
+
+namespace ASGE {
+
+	namespace
+	{
+		uint8_t toByte(float value) noexcept
+		{
+			value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+			return static_cast<uint8_t>(value * 255.0f + 0.5f);
+		}
+
+		uint32_t toPixel(const Colour& colour) noexcept
+		{
+			return toByte(colour.r) |
+				(toByte(colour.g) << 8) |
+				(toByte(colour.b) << 16) |
+				(0xFFu << 24);
+		}
+
+		uint16_t toFactor(float value) noexcept
+		{
+			value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+			return static_cast<uint16_t>(value * 256.0f + 0.5f);
+		}
+	}
+
+	SWRenderer::SWRenderer()
+		: Renderer(RenderLib::SOFTWARE)
+	{
+	}
+
+	void SWRenderer::setClearColour(Colour rgb)
+	{
+		cls = rgb;
+		clear_colour = toPixel(rgb);
+	}
+
+	int SWRenderer::loadFont(const char* font, int pt)
+	{
+		fonts.emplace_back(font, pt);
+		return static_cast<int>(fonts.size()) - 1;
+	}
+
+	bool SWRenderer::init(int w, int h, Renderer::WindowMode mode)
+	{
+		if (w <= 0 || h <= 0)
+		{
+			return false;
+		}
+
+		frame_width = w;
+		frame_height = h;
+		window_mode = mode;
+		frame.assign(static_cast<size_t>(w) * h, 0);
+		row.resize(w);
+		clear_colour = toPixel(cls);
+
+		fonts.clear();
+		fonts.emplace_back("default", 24);
+		active_font = 0;
+		return true;
+	}
+
+	bool SWRenderer::exit()
+	{
+		draws.clear();
+		texts.clear();
+		return true;
+	}
+
+	void SWRenderer::preRender()
+	{
+		SWBlend::fillRow(frame.data(), clear_colour, static_cast<int>(frame.size()));
+		frame_stats = Stats();
+		bound = nullptr;
+	}
+
+	/**
+	*  Draws anything batched during the frame.
+	*/
+	void SWRenderer::postRender()
+	{
+		flush();
+	}
+
+	void SWRenderer::renderText(const std::string str, int x, int y, float scale, const Colour& colour, float z_order)
+	{
+		//strings are kept between frames so their buffers are reused
+		if (text_count == texts.size())
+		{
+			texts.emplace_back();
+		}
+
+		Text& text = texts[text_count];
+		text.text.assign(str);
+		text.x = x;
+		text.y = y;
+		text.scale = scale;
+		text.colour = toPixel(colour);
+
+		if (sort_mode == SpriteSortMode::IMMEDIATE)
+		{
+			drawText(text);
+			return;
+		}
+
+		Draw cmd;
+		cmd.z_order = z_order;
+		cmd.text = text_count++;
+		cmd.order = static_cast<unsigned int>(draws.size());
+		draws.push_back(cmd);
+	}
+
+	void SWRenderer::setDefaultTextColour(const Colour& colour)
+	{
+		default_text_colour = colour;
+	}
+
+	const Font& SWRenderer::getActiveFont() const
+	{
+		return fonts[active_font];
+	}
+
+	void SWRenderer::setFont(int id)
+	{
+		if (id >= 0 && id < static_cast<int>(fonts.size()))
+		{
+			active_font = id;
+		}
+	}
+
+	/**
+	*  Records the sprite's state at the time of the call.
+	*  The sprite may be moved or changed before the batch is drawn.
+	*/
+	void SWRenderer::renderSprite(const Sprite& sprite, float z_order)
+	{
+		const SWTexture* texture = static_cast<const SWTexture*>(sprite.getTexture());
+		if (!texture || sprite.opacity() <= 0.0f)
+		{
+			return;
+		}
+
+		Draw cmd;
+		cmd.texture = texture;
+		std::memcpy(cmd.src, sprite.srcRect(), sizeof(cmd.src));
+		cmd.x = sprite.xPos();
+		cmd.y = sprite.yPos();
+		cmd.w = sprite.width() * sprite.scale();
+		cmd.h = sprite.height() * sprite.scale();
+		cmd.angle = sprite.rotationInRadians();
+		cmd.flip = (sprite.isFlippedOnX() ? Sprite::FLIP_X : 0) |
+			(sprite.isFlippedOnY() ? Sprite::FLIP_Y : 0);
+
+		//premultiplied, so opacity scales every channel
+		const Colour tint = sprite.colour();
+		const float alpha = sprite.opacity();
+		cmd.factors[0] = toFactor(tint.r * alpha);
+		cmd.factors[1] = toFactor(tint.g * alpha);
+		cmd.factors[2] = toFactor(tint.b * alpha);
+		cmd.factors[3] = toFactor(alpha);
+		cmd.z_order = z_order;
+		cmd.order = static_cast<unsigned int>(draws.size());
+
+		if (sort_mode == SpriteSortMode::IMMEDIATE)
+		{
+			draw(cmd);
+			return;
+		}
+
+		draws.push_back(cmd);
+	}
+
+	void SWRenderer::setSpriteMode(SpriteSortMode mode)
+	{
+		flush();
+		sort_mode = mode;
+	}
+
+	void SWRenderer::setWindowedMode(WindowMode mode)
+	{
+		window_mode = mode;
+	}
+
+	void SWRenderer::setWindowTitle(const char* str)
+	{
+		title = str ? str : "";
+	}
+
+	/**
+	*  Presents the frame.
+	*  There is no window, so this only counts frames and, if enabled,
+	*  writes the frame out to disk.
+	*/
+	void SWRenderer::swapBuffers()
+	{
+		if (!dump_directory.empty() && frames % dump_every == 0)
+		{
+			char file_name[32];
+			std::snprintf(file_name, sizeof(file_name), "/frame_%05u.png", frames);
+			saveFrame(dump_directory + file_name);
+		}
+
+		frames++;
+	}
+
+	std::unique_ptr<Input> SWRenderer::inputPtr()
+	{
+		return std::unique_ptr<Input>(new SWInput());
+	}
+
+	std::unique_ptr<Sprite> SWRenderer::createUniqueSprite()
+	{
+		return std::unique_ptr<Sprite>(new SWSprite());
+	}
+
+	Sprite* SWRenderer::createRawSprite()
+	{
+		return new SWSprite();
+	}
+
+	void SWRenderer::dumpFrames(const std::string& directory, unsigned int every_n)
+	{
+		dump_directory = directory;
+		dump_every = every_n ? every_n : 1;
+	}
+
+	bool SWRenderer::saveFrame(const std::string& file_name) const
+	{
+		if (frame.empty())
+		{
+			return false;
+		}
+
+		//the window has no alpha, so the frame is written opaque
+		std::vector<uint32_t> pixels(frame);
+		for (auto& pixel : pixels)
+		{
+			pixel |= 0xFFu << 24;
+		}
+
+		png_image png;
+		std::memset(&png, 0, sizeof(png));
+		png.version = PNG_IMAGE_VERSION;
+		png.width = static_cast<png_uint_32>(frame_width);
+		png.height = static_cast<png_uint_32>(frame_height);
+		png.format = PNG_FORMAT_RGBA;
+		return png_image_write_to_file(
+			&png, file_name.c_str(), 0, pixels.data(), 0, nullptr) != 0;
+	}
+
+	const uint32_t* SWRenderer::frameBuffer() const noexcept
+	{
+		return frame.data();
+	}
+
+	int SWRenderer::width() const noexcept
+	{
+		return frame_width;
+	}
+
+	int SWRenderer::height() const noexcept
+	{
+		return frame_height;
+	}
+
+	unsigned int SWRenderer::frameCount() const noexcept
+	{
+		return frames;
+	}
+
+	const SWRenderer::Stats& SWRenderer::stats() const noexcept
+	{
+		return frame_stats;
+	}
+
+	/**
+	*  Orders and draws the batch.
+	*  DEFERRED keeps the order of submission, TEXTURE groups by texture
+	*  and the depth modes sort by z order then texture. The submission
+	*  order is the final key, so equal items never swap between frames.
+	*/
+	void SWRenderer::flush()
+	{
+		auto by_texture = [](const Draw& lhs, const Draw& rhs)
+		{
+			if (lhs.texture != rhs.texture)
+			{
+				return std::less<const SWTexture*>()(lhs.texture, rhs.texture);
+			}
+
+			return lhs.order < rhs.order;
+		};
+
+		switch (sort_mode)
+		{
+		case SpriteSortMode::TEXTURE:
+			std::sort(draws.begin(), draws.end(), by_texture);
+			break;
+
+		case SpriteSortMode::BACK_TO_FRONT:
+			std::sort(draws.begin(), draws.end(), [&](const Draw& lhs, const Draw& rhs)
+			{
+				return lhs.z_order != rhs.z_order ?
+					lhs.z_order < rhs.z_order : by_texture(lhs, rhs);
+			});
+			break;
+
+		case SpriteSortMode::FRONT_TO_BACK:
+			std::sort(draws.begin(), draws.end(), [&](const Draw& lhs, const Draw& rhs)
+			{
+				return lhs.z_order != rhs.z_order ?
+					lhs.z_order > rhs.z_order : by_texture(lhs, rhs);
+			});
+			break;
+
+		default:
+			break;
+		}
+
+		for (const auto& cmd : draws)
+		{
+			if (cmd.texture)
+			{
+				draw(cmd);
+			}
+			else
+			{
+				drawText(texts[cmd.text]);
+			}
+		}
+
+		draws.clear();
+		text_count = 0;
+	}
+
+	/**
+	*  Rasterises an axis aligned sprite.
+	*  Each covered row gathers its texels into a scratch row, applies
+	*  the tint and opacity, then blends the row into the framebuffer.
+	*  A pixel is covered when its centre lies inside the sprite.
+	*/
+	void SWRenderer::draw(const Draw& cmd)
+	{
+		if (cmd.texture != bound || !frame_stats.batches)
+		{
+			frame_stats.batches++;
+			bound = cmd.texture;
+		}
+		frame_stats.sprites++;
+
+		if (cmd.angle != 0.0f)
+		{
+			drawRotated(cmd);
+			return;
+		}
+
+		if (cmd.w <= 0.0f || cmd.h <= 0.0f)
+		{
+			return;
+		}
+
+		const int x0 = std::max(0, static_cast<int>(std::ceil(cmd.x - 0.5f)));
+		const int y0 = std::max(0, static_cast<int>(std::ceil(cmd.y - 0.5f)));
+		const int x1 = std::min(frame_width, static_cast<int>(std::ceil(cmd.x + cmd.w - 0.5f)));
+		const int y1 = std::min(frame_height, static_cast<int>(std::ceil(cmd.y + cmd.h - 0.5f)));
+		if (x0 >= x1 || y0 >= y1)
+		{
+			return;
+		}
+
+		const int tex_w = static_cast<int>(cmd.texture->getWidth());
+		const int tex_h = static_cast<int>(cmd.texture->getHeight());
+		const int src_x = static_cast<int>(cmd.src[0]);
+		const int src_y = static_cast<int>(cmd.src[1]);
+		const int min_x = std::max(0, src_x);
+		const int min_y = std::max(0, src_y);
+		const int max_x = std::min(tex_w, src_x + static_cast<int>(cmd.src[2])) - 1;
+		const int max_y = std::min(tex_h, src_y + static_cast<int>(cmd.src[3])) - 1;
+		if (max_x < min_x || max_y < min_y)
+		{
+			return;
+		}
+
+		const float ratio_x = cmd.src[2] / cmd.w;
+		const float ratio_y = cmd.src[3] / cmd.h;
+		const bool flip_x = (cmd.flip & Sprite::FLIP_X) != 0;
+		const bool flip_y = (cmd.flip & Sprite::FLIP_Y) != 0;
+		const bool modulate = cmd.factors[0] != 256 || cmd.factors[1] != 256 ||
+			cmd.factors[2] != 256 || cmd.factors[3] != 256;
+
+		//16.16 fixed point texel stepping along the row
+		float u = (x0 + 0.5f - cmd.x) * ratio_x;
+		u = flip_x ? cmd.src[2] - u : u;
+		const int64_t u_start = static_cast<int64_t>((cmd.src[0] + u) * 65536.0f);
+		const int64_t u_step = static_cast<int64_t>(ratio_x * 65536.0f) * (flip_x ? -1 : 1);
+
+		const uint32_t* texels = cmd.texture->pixels();
+		const int count = x1 - x0;
+		for (int y = y0; y < y1; y++)
+		{
+			float v = (y + 0.5f - cmd.y) * ratio_y;
+			v = flip_y ? cmd.src[3] - v : v;
+			const int ty = std::min(max_y, std::max(min_y, static_cast<int>(cmd.src[1] + v)));
+			const uint32_t* texel_row = texels + static_cast<size_t>(ty) * tex_w;
+
+			int64_t u_fixed = u_start;
+			for (int i = 0; i < count; i++, u_fixed += u_step)
+			{
+				const int tx = std::min(max_x, std::max(min_x, static_cast<int>(u_fixed >> 16)));
+				row[i] = texel_row[tx];
+			}
+
+			if (modulate)
+			{
+				SWBlend::modulateRow(row.data(), count, cmd.factors);
+			}
+
+			SWBlend::blendRow(frame.data() + static_cast<size_t>(y) * frame_width + x0, row.data(), count);
+		}
+
+		frame_stats.pixels += static_cast<uint64_t>(count) * (y1 - y0);
+	}
+
+	/**
+	*  Rasterises a rotated sprite.
+	*  Every pixel in the rotated bounds is mapped back into the sprite
+	*  and sampled if it lands inside. Sprites rotate about their centre.
+	*/
+	void SWRenderer::drawRotated(const Draw& cmd)
+	{
+		if (cmd.w <= 0.0f || cmd.h <= 0.0f || cmd.src[2] <= 0.0f || cmd.src[3] <= 0.0f)
+		{
+			return;
+		}
+
+		const float centre_x = cmd.x + cmd.w * 0.5f;
+		const float centre_y = cmd.y + cmd.h * 0.5f;
+		const float radius = 0.5f * std::sqrt(cmd.w * cmd.w + cmd.h * cmd.h);
+		const int x0 = std::max(0, static_cast<int>(std::floor(centre_x - radius)));
+		const int y0 = std::max(0, static_cast<int>(std::floor(centre_y - radius)));
+		const int x1 = std::min(frame_width, static_cast<int>(std::ceil(centre_x + radius)));
+		const int y1 = std::min(frame_height, static_cast<int>(std::ceil(centre_y + radius)));
+
+		const int tex_w = static_cast<int>(cmd.texture->getWidth());
+		const int tex_h = static_cast<int>(cmd.texture->getHeight());
+		const float cos_a = std::cos(cmd.angle);
+		const float sin_a = std::sin(cmd.angle);
+		const float ratio_x = cmd.src[2] / cmd.w;
+		const float ratio_y = cmd.src[3] / cmd.h;
+		const uint32_t* texels = cmd.texture->pixels();
+
+		for (int y = y0; y < y1; y++)
+		{
+			uint32_t* dst = frame.data() + static_cast<size_t>(y) * frame_width;
+			const float dy = y + 0.5f - centre_y;
+			for (int x = x0; x < x1; x++)
+			{
+				const float dx = x + 0.5f - centre_x;
+				const float local_x = dx * cos_a + dy * sin_a + cmd.w * 0.5f;
+				const float local_y = dy * cos_a - dx * sin_a + cmd.h * 0.5f;
+				if (local_x < 0.0f || local_y < 0.0f || local_x >= cmd.w || local_y >= cmd.h)
+				{
+					continue;
+				}
+
+				float u = local_x * ratio_x;
+				float v = local_y * ratio_y;
+				u = (cmd.flip & Sprite::FLIP_X) ? cmd.src[2] - u : u;
+				v = (cmd.flip & Sprite::FLIP_Y) ? cmd.src[3] - v : v;
+				const int tx = std::min(tex_w - 1, std::max(0, static_cast<int>(cmd.src[0] + u)));
+				const int ty = std::min(tex_h - 1, std::max(0, static_cast<int>(cmd.src[1] + v)));
+
+				uint32_t texel = texels[static_cast<size_t>(ty) * tex_w + tx];
+				SWBlend::modulateRow(&texel, 1, cmd.factors);
+				dst[x] = SWBlend::blendPixel(dst[x], texel);
+				frame_stats.pixels++;
+			}
+		}
+	}
+
+	/**
+	*  Draws a string with the active font.
+	*  The y position is the baseline, matching the OpenGL renderer.
+	*/
+	void SWRenderer::drawText(const Text& text)
+	{
+		frame_stats.texts++;
+
+		const SWFont& font = fonts[active_font];
+		const int pixel = font.pixelSize(text.scale);
+		const int advance = (SWFont::GLYPH_WIDTH + 1) * pixel;
+		const int line_height = static_cast<int>(font.line_height * text.scale);
+
+		int pen_x = text.x;
+		int top = text.y - SWFont::GLYPH_HEIGHT * pixel;
+		for (char character : text.text)
+		{
+			if (character == '\n')
+			{
+				pen_x = text.x;
+				top += line_height;
+				continue;
+			}
+
+			const uint16_t bits = SWFont::glyph(character);
+			for (int gy = 0; bits && gy < SWFont::GLYPH_HEIGHT; gy++)
+			{
+				for (int gx = 0; gx < SWFont::GLYPH_WIDTH; gx++)
+				{
+					const int bit = 14 - (gy * SWFont::GLYPH_WIDTH + gx);
+					if (!(bits & (1 << bit)))
+					{
+						continue;
+					}
+
+					const int x0 = std::max(0, pen_x + gx * pixel);
+					const int x1 = std::min(frame_width, pen_x + (gx + 1) * pixel);
+					const int y0 = std::max(0, top + gy * pixel);
+					const int y1 = std::min(frame_height, top + (gy + 1) * pixel);
+					for (int y = y0; x0 < x1 && y < y1; y++)
+					{
+						SWBlend::fillRow(frame.data() + static_cast<size_t>(y) * frame_width + x0, text.colour, x1 - x0);
+					}
+				}
+			}
+
+			pen_x += advance;
+		}
+	}
+}
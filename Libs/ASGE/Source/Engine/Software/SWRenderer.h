@@ -0,0 +1,146 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <Engine/Renderer.h>
+#include "SWFont.h"
+
+namespace ASGE {
+
+	class SWTexture;
+
+	/**
+	*  A renderer that draws into system memory.
+	*  Needs no window or GPU, which makes it suitable for servers,
+	*  CI and benchmarking. Sprites are rasterised into a 32 bit
+	*  premultiplied RGBA framebuffer using nearest neighbour sampling
+	*  and SIMD blending. Frames can be written out as png files so
+	*  they can be inspected or compared.
+	*/
+	class SWRenderer : public Renderer
+	{
+	public:
+
+		/**
+		*  Counters describing the last rendered frame.
+		*/
+		struct Stats
+		{
+			unsigned int sprites = 0;      /**< Sprites drawn. */
+			unsigned int texts = 0;        /**< Text strings drawn. */
+			unsigned int batches = 0;      /**< Runs of sprites sharing a texture. */
+			uint64_t pixels = 0;           /**< Pixels blended. */
+		};
+
+		SWRenderer();
+		virtual ~SWRenderer() = default;
+
+		virtual void setClearColour(Colour rgb) override;
+		virtual int  loadFont(const char* font, int pt) override;
+		virtual bool init(int w, int h, Renderer::WindowMode mode) override;
+		virtual bool exit() override;
+		virtual void preRender() override;
+		virtual void postRender() override;
+		virtual void renderText(const std::string str, int x, int y, float scale, const Colour& colour, float z_order) override;
+		virtual void setDefaultTextColour(const Colour& colour) override;
+		virtual const Font& getActiveFont() const override;
+		virtual void setFont(int id) override;
+		virtual void renderSprite(const Sprite& sprite, float z_order) override;
+		virtual void setSpriteMode(SpriteSortMode mode) override;
+		virtual void setWindowedMode(WindowMode mode) override;
+		virtual void setWindowTitle(const char* str) override;
+		virtual void swapBuffers() override;
+		virtual std::unique_ptr<Input> inputPtr() override;
+		virtual std::unique_ptr<Sprite> createUniqueSprite() override;
+		virtual Sprite* createRawSprite() override;
+
+		using Renderer::renderText;
+		using Renderer::renderSprite;
+
+		/**
+		*  Writes every nth presented frame to a directory.
+		*  Frames are named frame_00000.png onwards.
+		*  @param [in] directory The directory to write to, empty to stop.
+		*  @param [in] every_n How many frames to skip between dumps.
+		*/
+		void dumpFrames(const std::string& directory, unsigned int every_n = 1);
+
+		/**
+		*  Writes the framebuffer to a png file.
+		*  @param [in] file_name The file to write.
+		*  @return True if the file was written.
+		*/
+		bool saveFrame(const std::string& file_name) const;
+
+		/**
+		*  Returns the framebuffer.
+		*  @return width * height premultiplied RGBA pixels.
+		*/
+		const uint32_t* frameBuffer() const noexcept;
+
+		int width() const noexcept;
+		int height() const noexcept;
+
+		/**
+		*  Returns the number of frames presented.
+		*/
+		unsigned int frameCount() const noexcept;
+
+		/**
+		*  Returns the counters for the last frame.
+		*/
+		const Stats& stats() const noexcept;
+
+	private:
+		struct Draw
+		{
+			const SWTexture* texture = nullptr;
+			float src[4]{ 0,0,0,0 };
+			float x = 0;
+			float y = 0;
+			float w = 0;
+			float h = 0;
+			float angle = 0;
+			int flip = 0;
+			uint16_t factors[4]{ 256,256,256,256 };
+			float z_order = 0;
+			size_t text = 0;
+			unsigned int order = 0;
+		};
+
+		struct Text
+		{
+			std::string text;
+			int x = 0;
+			int y = 0;
+			float scale = 1.0f;
+			uint32_t colour = 0;
+		};
+
+		void flush();
+		void draw(const Draw& cmd);
+		void drawRotated(const Draw& cmd);
+		void drawText(const Text& text);
+
+		int frame_width = 0;
+		int frame_height = 0;
+		std::vector<uint32_t> frame;
+		std::vector<uint32_t> row;
+		uint32_t clear_colour = 0;
+
+		SpriteSortMode sort_mode = SpriteSortMode::DEFERRED;
+		std::vector<Draw> draws;
+		std::vector<Text> texts;
+		size_t text_count = 0;
+		const SWTexture* bound = nullptr;
+
+		std::vector<SWFont> fonts;
+		int active_font = 0;
+		std::string title;
+
+		std::string dump_directory;
+		unsigned int dump_every = 1;
+		unsigned int frames = 0;
+		Stats frame_stats;
+	};
+}
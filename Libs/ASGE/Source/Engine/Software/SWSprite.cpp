@@ -0,0 +1,27 @@
+#include "SWSprite.h"
+
+namespace ASGE {
+
+	bool SWSprite::loadTexture(const std::string& file_name)
+	{
+		auto loaded = SWTextureCache::global().load(file_name);
+		if (!loaded)
+		{
+			return false;
+		}
+
+		texture = loaded;
+		dims[0] = static_cast<float>(texture->getWidth());
+		dims[1] = static_cast<float>(texture->getHeight());
+		src_rect[0] = 0;
+		src_rect[1] = 0;
+		src_rect[2] = dims[0];
+		src_rect[3] = dims[1];
+		return true;
+	}
+
+	const Texture2D* SWSprite::getTexture() const
+	{
+		return texture.get();
+	}
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <memory>
+#include <Engine/Sprite.h>
+#include "SWTexture.h"
+
+namespace ASGE {
+
+	/**
+	*  A sprite drawn by the software renderer.
+	*  Holds a shared reference to its texture in the SWTextureCache.
+	*/
+	class SWSprite : public Sprite
+	{
+	public:
+		SWSprite() noexcept { flip_flags = NORMAL; }
+		virtual ~SWSprite() = default;
+
+		/**
+		*  Loads or shares the texture and resizes the sprite to it.
+		*  @param [in] file_name The image to load.
+		*  @return True if the texture was loaded.
+		*/
+		virtual bool loadTexture(const std::string& file_name) override;
+
+		/**
+		*  Returns the sprite's texture.
+		*  @return The texture or nullptr if none has been loaded.
+		*/
+		virtual const Texture2D* getTexture() const override;
+
+	private:
+		std::shared_ptr<SWTexture> texture;
+	};
+}
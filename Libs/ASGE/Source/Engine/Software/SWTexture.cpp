@@ -0,0 +1,121 @@
+#include <cstring>
+#include <png.h>
+#include <MappedFile.h>
+#include "SWTexture.h"
+
+namespace ASGE {
+
+	SWTexture::SWTexture(int width, int height)
+		: Texture2D(width, height),
+		texels(static_cast<size_t>(width) * height, 0)
+	{
+		format = RGBA;
+	}
+
+	void SWTexture::setData(void* data)
+	{
+		std::memcpy(texels.data(), data, texels.size() * sizeof(uint32_t));
+	}
+
+	void* SWTexture::getData()
+	{
+		return texels.data();
+	}
+
+	SWTextureCache& SWTextureCache::global()
+	{
+		static SWTextureCache cache;
+		return cache;
+	}
+
+	std::shared_ptr<SWTexture> SWTextureCache::load(const std::string& file_name)
+	{
+		const std::string path = hostPath(file_name);
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			auto found = textures.find(path);
+			if (found != textures.end())
+			{
+				return found->second;
+			}
+		}
+
+		int width = 0, height = 0;
+		std::vector<uint32_t> pixels;
+		if (!decode(path, width, height, pixels))
+		{
+			return nullptr;
+		}
+
+		return insert(path, width, height, pixels.data());
+	}
+
+	std::shared_ptr<SWTexture> SWTextureCache::insert(
+		const std::string& file_name, int width, int height, const uint32_t* pixels)
+	{
+		auto texture = std::make_shared<SWTexture>(width, height);
+		texture->setData(const_cast<uint32_t*>(pixels));
+
+		std::lock_guard<std::mutex> guard(lock);
+		auto& slot = textures[hostPath(file_name)];
+		if (!slot)
+		{
+			slot = texture;
+		}
+
+		return slot;
+	}
+
+	/**
+	*  Decodes a png and premultiplies its alpha.
+	*  Uses libpng's simplified API which converts every colour type
+	*  and bit depth into 8 bit RGBA.
+	*/
+	bool SWTextureCache::decode(
+		const std::string& file_name, int& width, int& height, std::vector<uint32_t>& pixels)
+	{
+		png_image png;
+		std::memset(&png, 0, sizeof(png));
+		png.version = PNG_IMAGE_VERSION;
+
+		if (!png_image_begin_read_from_file(&png, hostPath(file_name).c_str()))
+		{
+			return false;
+		}
+
+		png.format = PNG_FORMAT_RGBA;
+		width = static_cast<int>(png.width);
+		height = static_cast<int>(png.height);
+		pixels.resize(static_cast<size_t>(width) * height);
+		if (!png_image_finish_read(&png, nullptr, pixels.data(), 0, nullptr))
+		{
+			png_image_free(&png);
+			return false;
+		}
+
+		for (auto& pixel : pixels)
+		{
+			const uint32_t a = pixel >> 24;
+			if (a == 255)
+			{
+				continue;
+			}
+
+			const uint32_t r = ((pixel & 0xFF) * a + 127) / 255;
+			const uint32_t g = (((pixel >> 8) & 0xFF) * a + 127) / 255;
+			const uint32_t b = (((pixel >> 16) & 0xFF) * a + 127) / 255;
+			pixel = r | (g << 8) | (b << 16) | (a << 24);
+		}
+
+		return true;
+	}
+
+	void SWTextureCache::clear()
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		for (auto itr = textures.begin(); itr != textures.end();)
+		{
+			itr = itr->second.use_count() == 1 ? textures.erase(itr) : std::next(itr);
+		}
+	}
+}
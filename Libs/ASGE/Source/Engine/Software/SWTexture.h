@@ -0,0 +1,109 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <Engine/Texture.h>
+
+namespace ASGE {
+
+	/**
+	*  A texture held in system memory.
+	*  Pixels are stored as 32 bit RGBA with premultiplied alpha, which
+	*  is the format the software rasteriser blends in. setData expects
+	*  pixels already in this format.
+	*/
+	class SWTexture : public Texture2D
+	{
+	public:
+
+		/**
+		*  Constructor. Allocates a transparent texture.
+		*  @param [in] width The width in pixels.
+		*  @param [in] height The height in pixels.
+		*/
+		SWTexture(int width, int height);
+		virtual ~SWTexture() = default;
+
+		/**
+		*  Replaces the texture's pixels.
+		*  @param [in] data width * height premultiplied RGBA pixels.
+		*/
+		virtual void  setData(void* data) override;
+
+		/**
+		*  Returns the texture's pixels.
+		*  @return width * height premultiplied RGBA pixels.
+		*/
+		virtual void* getData() override;
+
+		/**
+		*  Returns the texture's pixels.
+		*  @return width * height premultiplied RGBA pixels.
+		*/
+		const uint32_t* pixels() const noexcept { return texels.data(); }
+
+	private:
+		std::vector<uint32_t> texels;
+	};
+
+	/**
+	*  Path keyed store of decoded textures.
+	*  Textures are decoded on first use and shared by every sprite that
+	*  loads the same file. Thread safe, so images can be decoded away
+	*  from the main thread and inserted once ready.
+	*/
+	class SWTextureCache
+	{
+	public:
+
+		/**
+		*  Returns the process wide texture store.
+		*/
+		static SWTextureCache& global();
+
+		/**
+		*  Finds or decodes a texture.
+		*  @param [in] file_name The image to load.
+		*  @return The texture or nullptr if it could not be decoded.
+		*/
+		std::shared_ptr<SWTexture> load(const std::string& file_name);
+
+		/**
+		*  Registers already decoded pixels under a file name.
+		*  Later loads of the file use these pixels without decoding.
+		*  @param [in] file_name The name to register the pixels under.
+		*  @param [in] width The width in pixels.
+		*  @param [in] height The height in pixels.
+		*  @param [in] pixels width * height premultiplied RGBA pixels.
+		*  @return The texture.
+		*/
+		std::shared_ptr<SWTexture> insert(
+			const std::string& file_name, int width, int height, const uint32_t* pixels);
+
+		/**
+		*  Decodes an image file into premultiplied RGBA pixels.
+		*  Does not touch the cache, so it may be called from any thread.
+		*  @param [in] file_name The image to decode.
+		*  @param [out] width The width in pixels.
+		*  @param [out] height The height in pixels.
+		*  @param [out] pixels The decoded pixels.
+		*  @return True if the image was decoded.
+		*/
+		static bool decode(
+			const std::string& file_name, int& width, int& height, std::vector<uint32_t>& pixels);
+
+		/**
+		*  Releases every texture not held by a sprite.
+		*/
+		void clear();
+
+	private:
+		SWTextureCache() = default;
+
+		std::mutex lock;
+		std::unordered_map<std::string, std::shared_ptr<SWTexture>> textures;
+	};
+}
@@ -0,0 +1,115 @@
+#include <Engine/Sprite.h>
+
+namespace ASGE {
+
+	float Sprite::xPos() const noexcept
+	{
+		return position[0];
+	}
+
+	void Sprite::xPos(float x) noexcept
+	{
+		position[0] = x;
+	}
+
+	float Sprite::yPos() const noexcept
+	{
+		return position[1];
+	}
+
+	void Sprite::yPos(float y) noexcept
+	{
+		position[1] = y;
+	}
+
+	float Sprite::width() const noexcept
+	{
+		return dims[0];
+	}
+
+	void Sprite::width(float width) noexcept
+	{
+		dims[0] = width;
+	}
+
+	float Sprite::height() const noexcept
+	{
+		return dims[1];
+	}
+
+	void Sprite::height(float height) noexcept
+	{
+		dims[1] = height;
+	}
+
+	void Sprite::dimensions(float& width, float& height) const noexcept
+	{
+		width = dims[0];
+		height = dims[1];
+	}
+
+	float Sprite::rotationInRadians() const noexcept
+	{
+		return angle;
+	}
+
+	void Sprite::rotationInRadians(float rotation_radians)
+	{
+		angle = rotation_radians;
+	}
+
+	float Sprite::scale() const noexcept
+	{
+		return scale_factor;
+	}
+
+	void Sprite::scale(float scale_value) noexcept
+	{
+		scale_factor = scale_value;
+	}
+
+	Colour Sprite::colour() const noexcept
+	{
+		return tint;
+	}
+
+	void Sprite::colour(ASGE::Colour sprite_colour) noexcept
+	{
+		tint = sprite_colour;
+	}
+
+	bool Sprite::isFlippedOnX() const noexcept
+	{
+		return (flip_flags & FLIP_X) != 0;
+	}
+
+	bool Sprite::isFlippedOnY() const noexcept
+	{
+		return (flip_flags & FLIP_Y) != 0;
+	}
+
+	void Sprite::setFlipFlags(FlipFlags flags) noexcept
+	{
+		flip_flags = flags;
+	}
+
+	void Sprite::opacity(float alpha) noexcept
+	{
+		this->alpha = alpha;
+	}
+
+	float Sprite::opacity() const noexcept
+	{
+		return alpha;
+	}
+
+	float* Sprite::srcRect() noexcept
+	{
+		return src_rect;
+	}
+
+	const float* Sprite::srcRect() const noexcept
+	{
+		return src_rect;
+	}
+}
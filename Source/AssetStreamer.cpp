@@ -0,0 +1,175 @@
+#include <algorithm>
+#include "AssetStreamer.h"
+#include "TextureCache.h"
+
+/**
+*   @brief   Constructor.
+*   @details The workers sleep until a file is requested.
+*/
+AssetStreamer::AssetStreamer(unsigned int threads)
+{
+	threads = std::max(threads, 1u);
+	for (unsigned int i = 0; i < threads; i++)
+	{
+		workers.emplace_back(&AssetStreamer::work, this);
+	}
+}
+
+/**
+*   @brief   Destructor.
+*   @details Files still queued are dropped, files being read are
+             finished first.
+*/
+AssetStreamer::~AssetStreamer()
+{
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		stopping = true;
+		queued.clear();
+	}
+
+	wake.notify_all();
+	for (auto& worker : workers)
+	{
+		worker.join();
+	}
+}
+
+/**
+*   @brief   Queues a texture to be loaded.
+*   @details Paths are compared against the files in flight rather
+             than copied, so asking again for a file that is already
+             loading does not allocate. A file that failed is kept
+             apart, so it is reported rather than retried every frame.
+*   @return  Where the texture is up to.
+*/
+AssetStreamer::Status AssetStreamer::request(const std::string& texture_file_name)
+{
+	if (TextureCache::global().isResident(texture_file_name))
+	{
+		return Status::READY;
+	}
+
+	if (std::find(failed_files.begin(), failed_files.end(), texture_file_name) != failed_files.end())
+	{
+		return Status::FAILED;
+	}
+
+	if (std::find(requested.begin(), requested.end(), texture_file_name) != requested.end())
+	{
+		return Status::LOADING;
+	}
+
+	//a request made while idle starts a new batch for progress
+	if (!busy())
+	{
+		counts = Progress();
+	}
+
+	requested.push_back(texture_file_name);
+	counts.requested++;
+	in_flight++;
+
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		queued.emplace_back();
+		queued.back().file_name = texture_file_name;
+	}
+
+	wake.notify_one();
+	return Status::LOADING;
+}
+
+void AssetStreamer::retry()
+{
+	failed_files.clear();
+}
+
+/**
+*   @brief   Makes finished files resident.
+*   @details The workers have decoded each file, so making it
+             resident only uploads its pixels. A file the workers could
+             not decode is loaded from its path, as the real engine
+             only decodes cooked images off the main thread.
+*   @see     TextureCache::decode
+*   @return  The number of files made resident.
+*/
+unsigned int AssetStreamer::upload(ASGE::Renderer* renderer, unsigned int budget)
+{
+	unsigned int uploaded = 0;
+	while (uploaded < budget)
+	{
+		Load load;
+		{
+			std::lock_guard<std::mutex> guard(mutex);
+			if (finished.empty())
+			{
+				break;
+			}
+
+			load = std::move(finished.front());
+			finished.pop_front();
+		}
+
+		in_flight--;
+		requested.erase(std::find(requested.begin(), requested.end(), load.file_name));
+		const bool loaded = load.decoded ?
+			TextureCache::global().upload(renderer, load.image) :
+			TextureCache::global().preload(renderer, load.file_name);
+		if (loaded)
+		{
+			counts.loaded++;
+		}
+		else
+		{
+			counts.failed++;
+			failed_files.push_back(std::move(load.file_name));
+		}
+
+		uploaded++;
+	}
+
+	return uploaded;
+}
+
+bool AssetStreamer::busy() const
+{
+	return in_flight != 0;
+}
+
+AssetStreamer::Progress AssetStreamer::progress() const
+{
+	return counts;
+}
+
+float AssetStreamer::fraction() const
+{
+	if (!counts.requested)
+	{
+		return 1.0f;
+	}
+
+	return static_cast<float>(counts.loaded + counts.failed) / counts.requested;
+}
+
+void AssetStreamer::work()
+{
+	std::unique_lock<std::mutex> guard(mutex);
+	while (true)
+	{
+		wake.wait(guard, [this] { return stopping || !queued.empty(); });
+		if (stopping)
+		{
+			return;
+		}
+
+		Load load = std::move(queued.front());
+		queued.pop_front();
+
+		guard.unlock();
+		load.decoded = TextureCache::decode(load.file_name, load.image);
+		guard.lock();
+
+		finished.push_back(std::move(load));
+	}
+}
@@ -0,0 +1,119 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "TexturePixels.h"
+
+namespace ASGE {
+	class Renderer;
+}
+
+/**
+*  Loads textures in the background.
+*  Files are requested by path and decoded into memory on worker
+*  threads. Finished files wait until the main thread calls upload,
+*  which makes a few of them resident in the TextureCache each frame,
+*  so later requests for them are cache hits that never touch the disk.
+*  Files that fail are reported by request until retry is called.
+*  @see TextureCache::decode
+*/
+class AssetStreamer
+{
+public:
+
+	/**
+	*  Where a requested file is up to.
+	*/
+	enum class Status
+	{
+		LOADING,    /**< Queued, decoding or waiting for upload. */
+		READY,      /**< Resident in the TextureCache. */
+		FAILED      /**< Could not be loaded, and is not retried until retry is called. */
+	};
+
+	/**
+	*  Counts of the files requested so far.
+	*/
+	struct Progress
+	{
+		unsigned int requested = 0;     /**< Files requested, including those already resident. */
+		unsigned int loaded = 0;        /**< Files now resident in the TextureCache. */
+		unsigned int failed = 0;        /**< Files that could not be read or decoded. */
+	};
+
+	/**
+	*  Constructor. Starts the workers.
+	*  @param [in] threads The number of worker threads.
+	*/
+	explicit AssetStreamer(unsigned int threads = 1);
+
+	/**
+	*  Destructor. Stops the workers, files not yet loaded are dropped.
+	*/
+	~AssetStreamer();
+
+	AssetStreamer(const AssetStreamer&) = delete;
+	AssetStreamer& operator=(const AssetStreamer&) = delete;
+
+	/**
+	*  Queues a texture to be loaded.
+	*  Files already resident, already requested or that have failed
+	*  are not loaded again, so this may be called every frame.
+	*  @param [in] texture_file_name The file path to the texture
+	*  @return where the texture is up to
+	*/
+	Status request(const std::string& texture_file_name);
+
+	/**
+	*  Forgets the files that failed, so requesting them loads them again.
+	*/
+	void retry();
+
+	/**
+	*  Makes finished files resident. Call from the main thread.
+	*  @param [in] renderer The renderer used to create the textures
+	*  @param [in] budget The most files to make resident this call
+	*  @return the number of files made resident
+	*/
+	unsigned int upload(ASGE::Renderer* renderer, unsigned int budget);
+
+	/**
+	*  Returns true while requested files are still loading.
+	*/
+	bool busy() const;
+
+	/**
+	*  Returns the counts of requested and loaded files.
+	*/
+	Progress progress() const;
+
+	/**
+	*  Returns the fraction of requested files that are finished.
+	*  @return 1 when nothing is loading
+	*/
+	float fraction() const;
+
+private:
+	struct Load
+	{
+		std::string file_name;
+		TexturePixels image;
+		bool decoded = false;
+	};
+
+	void work();
+
+	std::vector<std::thread> workers;
+	mutable std::mutex mutex;
+	std::condition_variable wake;
+	std::deque<Load> queued;
+	std::deque<Load> finished;
+	std::vector<std::string> requested;
+	std::vector<std::string> failed_files;
+	Progress counts;
+	unsigned int in_flight = 0;
+	bool stopping = false;
+};
@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdint>
+
+/**
+*  On disk layout of a packed atlas index.
+*  Written by the AtlasPacker tool and read by TextureAtlas::loadIndex.
+*  All values are little endian. The file starts with a Header, which
+*  is followed by the page table, the entry table and lastly a block of
+*  null terminated strings that the tables reference by offset. Page
+*  file names are relative to the index file.
+*/
+namespace AtlasIndex
+{
+	constexpr char     MAGIC[4] = { 'A', 'B', 'A', 'T' };
+	constexpr uint16_t VERSION  = 1;
+
+#pragma pack(push, 1)
+	struct Header
+	{
+		char     magic[4];     /**< Always MAGIC. */
+		uint16_t version;      /**< Always VERSION. */
+		uint16_t page_count;   /**< Number of Page records. */
+		uint32_t entry_count;  /**< Number of Entry records. */
+		uint32_t string_bytes; /**< Size of the string block. */
+	};
+
+	struct Page
+	{
+		uint32_t file_name;    /**< Offset of the page's image file name. */
+		uint16_t width;        /**< Page width in pixels. */
+		uint16_t height;       /**< Page height in pixels. */
+	};
+
+	struct Entry
+	{
+		uint32_t name;         /**< Offset of the packed image's file name. */
+		uint16_t page;         /**< Index of the page holding the image. */
+		uint16_t x;            /**< Region within the page. */
+		uint16_t y;
+		uint16_t width;
+		uint16_t height;
+	};
+#pragma pack(pop)
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include "Rect.h"
+
+namespace ASGE {
+	class Sprite;
+}
+
+/**
+*  Where an entity is and how big it is.
+*  The simulation moves transforms; sprites are only told where to be
+*  once a tick has finished.
+*/
+struct Transform
+{
+	float x = 0;
+	float y = 0;
+	float length = 0;
+	float height = 0;
+
+	rect bounds() const noexcept
+	{
+		rect box;
+		box.x = x;
+		box.y = y;
+		box.length = length;
+		box.height = height;
+		return box;
+	}
+};
+
+/**
+*  A rock that can be picked up and fired from the catapult.
+*/
+struct Projectile
+{
+	bool visible = false;
+	bool selected = false;
+	bool fired = false;
+	int body = -1;          /**< The physics body while in flight, or -1. */
+	float moved_x = 0;      /**< How far the rock flew this tick. */
+	float moved_y = 0;
+};
+
+/**
+*  Something rocks can hit, such as a roof.
+*/
+struct Target
+{
+	int hits = 0;
+	bool standing = false;
+	int body = -1;          /**< The physics body, or -1 once a destroyed roof has settled. */
+};
+
+/**
+*  The sprite drawing an entity at its transform.
+*  The sprite is owned elsewhere.
+*/
+struct Renderable
+{
+	ASGE::Sprite* sprite = nullptr;
+};
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+
+/**
+*  On disk layout of the cooked texture cache.
+*  Written by the TextureCooker tool and mapped by CookedTextures. Each
+*  image is cooked into its own blob, named after the 64 bit FNV-1a hash
+*  of the source file's bytes as 16 hex digits plus ".tex", so identical
+*  images share a blob and a changed image gets a new one. A blob is a
+*  BlobHeader followed by width * height premultiplied RGBA pixels, the
+*  format the headless engine blends in. Next to each blob is its shell,
+*  the same name ending ".png" instead: a blank RGBA image of the same
+*  size, which the real engine loads to create a texture that the
+*  blob's pixels are then uploaded into. The index maps the game's
+*  image paths to those hashes: an IndexHeader, the entry table and a
+*  block of null terminated strings the entries reference by offset.
+*  Paths use forward slashes and are relative to the working directory,
+*  e.g. "Resources/images/army.png". All values are little endian and
+*  every record is a multiple of eight bytes, keeping the pixels aligned
+*  in the mapping.
+*/
+namespace CookedFormat
+{
+	constexpr char     BLOB_MAGIC[4]  = { 'A', 'B', 'T', 'X' };
+	constexpr char     INDEX_MAGIC[4] = { 'A', 'B', 'T', 'I' };
+	constexpr uint16_t VERSION        = 1;
+	constexpr const char* INDEX_FILE  = "textures.idx";
+
+#pragma pack(push, 1)
+	struct BlobHeader
+	{
+		char     magic[4];         /**< Always BLOB_MAGIC. */
+		uint16_t version;          /**< Always VERSION. */
+		uint16_t reserved;
+		uint32_t width;            /**< Width in pixels. */
+		uint32_t height;           /**< Height in pixels. */
+		uint64_t source_hash;      /**< Hash of the source image, as in the blob's name. */
+	};
+
+	struct IndexHeader
+	{
+		char     magic[4];         /**< Always INDEX_MAGIC. */
+		uint16_t version;          /**< Always VERSION. */
+		uint16_t reserved;
+		uint32_t entry_count;      /**< Number of IndexEntry records. */
+		uint32_t string_bytes;     /**< Size of the string block. */
+	};
+
+	struct IndexEntry
+	{
+		uint32_t path;             /**< Offset of the image's path. */
+		uint32_t reserved;
+		uint64_t source_hash;      /**< Hash of the image's bytes when it was cooked. */
+	};
+#pragma pack(pop)
+
+	static_assert(sizeof(BlobHeader) == 24, "BlobHeader must keep the pixels 8 byte aligned");
+	static_assert(sizeof(IndexHeader) == 16, "IndexHeader must keep the entries 8 byte aligned");
+	static_assert(sizeof(IndexEntry) == 16, "IndexEntry must keep the entries 8 byte aligned");
+}
@@ -0,0 +1,196 @@
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <Engine/Sprite.h>
+#include <Engine/Texture.h>
+#ifdef ASGE_HEADLESS
+#include <SWTexture.h>
+#endif
+#include "CookedFormat.h"
+#include "CookedTextures.h"
+#include "MappedFile.h"
+
+namespace
+{
+	std::string cookedName(uint64_t source_hash, const char* extension)
+	{
+		char name[24];
+		std::snprintf(name, sizeof(name), "%016" PRIx64 "%s", source_hash, extension);
+		return name;
+	}
+}
+
+/**
+*   @brief   Reads a cooked cache's index.
+*   @details The entries are copied out of the index, so the index
+             itself is not kept mapped. A cache whose tables do not
+             add up to the file's size is rejected whole.
+*   @return  True if successful.
+*/
+bool CookedTextures::mount(const std::string& cache_directory)
+{
+	using namespace CookedFormat;
+	unmount();
+
+	MappedFile index;
+	if (!index.open(cache_directory + INDEX_FILE) || index.size() < sizeof(IndexHeader))
+	{
+		return false;
+	}
+
+	IndexHeader header;
+	std::memcpy(&header, index.data(), sizeof(header));
+	const size_t strings_offset = sizeof(IndexHeader) + size_t(header.entry_count) * sizeof(IndexEntry);
+	if (std::memcmp(header.magic, INDEX_MAGIC, sizeof(header.magic)) ||
+		header.version != VERSION ||
+		strings_offset + header.string_bytes != index.size() ||
+		!header.string_bytes || index.data()[index.size() - 1] != '\0')
+	{
+		return false;
+	}
+
+	const char* strings = reinterpret_cast<const char*>(index.data() + strings_offset);
+	for (uint32_t i = 0; i < header.entry_count; i++)
+	{
+		IndexEntry entry;
+		std::memcpy(&entry, index.data() + sizeof(IndexHeader) + i * sizeof(IndexEntry), sizeof(entry));
+		if (entry.path >= header.string_bytes)
+		{
+			unmount();
+			return false;
+		}
+
+		entries[strings + entry.path].source_hash = entry.source_hash;
+	}
+
+	directory = cache_directory;
+	return true;
+}
+
+void CookedTextures::unmount()
+{
+	directory.clear();
+	entries.clear();
+	installed_count = 0;
+	installed_bytes = 0;
+}
+
+/**
+*   @brief   Reads a cooked image.
+*   @details The blob is mapped, checked against the index and its
+             pixels copied out, then unmapped again. The real engine
+             blends straight alpha, so there the pixels are divided
+             back out of their premultiplied form as they are copied.
+*   @return  True if successful.
+*/
+bool CookedTextures::read(const std::string& texture_file_name, TexturePixels& image)
+{
+	using namespace CookedFormat;
+	auto found = entries.find(hostPath(texture_file_name));
+	if (found == entries.end())
+	{
+		return false;
+	}
+
+	const uint64_t source_hash = found->second.source_hash;
+	MappedFile blob;
+	if (!blob.open(directory + cookedName(source_hash, ".tex")) || blob.size() < sizeof(BlobHeader))
+	{
+		return false;
+	}
+
+	BlobHeader header;
+	std::memcpy(&header, blob.data(), sizeof(header));
+	const size_t pixel_count = size_t(header.width) * header.height;
+	if (std::memcmp(header.magic, BLOB_MAGIC, sizeof(header.magic)) ||
+		header.version != VERSION ||
+		header.source_hash != source_hash ||
+		sizeof(BlobHeader) + pixel_count * sizeof(uint32_t) != blob.size())
+	{
+		return false;
+	}
+
+	image.file_name = texture_file_name;
+	image.width = static_cast<int>(header.width);
+	image.height = static_cast<int>(header.height);
+	image.source_hash = source_hash;
+	image.pixels.resize(pixel_count);
+	std::memcpy(image.pixels.data(), blob.data() + sizeof(BlobHeader), pixel_count * sizeof(uint32_t));
+#ifndef ASGE_HEADLESS
+	unsigned char* bytes = reinterpret_cast<unsigned char*>(image.pixels.data());
+	for (size_t i = 0; i < pixel_count; i++, bytes += 4)
+	{
+		const unsigned int alpha = bytes[3];
+		if (alpha && alpha != 255)
+		{
+			bytes[0] = static_cast<unsigned char>((bytes[0] * 255u + alpha / 2) / alpha);
+			bytes[1] = static_cast<unsigned char>((bytes[1] * 255u + alpha / 2) / alpha);
+			bytes[2] = static_cast<unsigned char>((bytes[2] * 255u + alpha / 2) / alpha);
+		}
+	}
+#endif
+
+	return true;
+}
+
+/**
+*   @brief   Installs an image as a sprite's texture.
+*   @details Headless, the pixels go into the engine's texture store
+             under the game path and the sprite loads them from there.
+             The real engine loads the image's shell, a blank image the
+             cooker writes at the same size, then uploads the pixels
+             over it with setData. Sprites bound to the shell's path
+             later share that texture.
+*   @return  True if successful.
+*/
+bool CookedTextures::install(ASGE::Sprite* sprite, const TexturePixels& image, std::string& bound_file)
+{
+#ifdef ASGE_HEADLESS
+	ASGE::SWTextureCache::global().insert(image.file_name, image.width, image.height, image.pixels.data());
+	if (!sprite->loadTexture(image.file_name))
+	{
+		return false;
+	}
+
+	bound_file = image.file_name;
+#else
+	const std::string shell = directory + cookedName(image.source_hash, ".png");
+	if (!image.source_hash || !sprite->loadTexture(shell))
+	{
+		return false;
+	}
+
+	auto texture = const_cast<ASGE::Texture2D*>(sprite->getTexture());
+	if (!texture || texture->getFormat() != ASGE::Texture2D::RGBA ||
+		texture->getWidth() != static_cast<unsigned int>(image.width) ||
+		texture->getHeight() != static_cast<unsigned int>(image.height))
+	{
+		return false;
+	}
+
+	texture->setData(const_cast<uint32_t*>(image.pixels.data()));
+	bound_file = shell;
+#endif
+
+	if (image.source_hash)
+	{
+		auto found = entries.find(hostPath(image.file_name));
+		if (found != entries.end() && !found->second.installed.exchange(true, std::memory_order_acq_rel))
+		{
+			installed_count++;
+			installed_bytes += image.pixels.size() * sizeof(uint32_t);
+		}
+	}
+
+	return true;
+}
+
+unsigned int CookedTextures::installed() const noexcept
+{
+	return installed_count.load();
+}
+
+size_t CookedTextures::installedBytes() const noexcept
+{
+	return installed_bytes.load();
+}
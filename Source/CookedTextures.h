@@ -0,0 +1,84 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include "TexturePixels.h"
+
+namespace ASGE {
+	class Sprite;
+}
+
+/**
+*  The cooked texture cache written by the TextureCooker tool.
+*  Cooked images are stored already decoded and premultiplied, so
+*  reading one maps its blob and copies the pixels out, with no
+*  inflating. The index is read once by mount, after which read may be
+*  called from any thread. install then hands the pixels to the engine
+*  on the main thread. The real engine can only create a texture by
+*  loading a file, so it loads the blank shell image cooked alongside
+*  each blob and replaces the shell's pixels with Texture2D::setData.
+*  @see CookedFormat
+*/
+class CookedTextures
+{
+public:
+
+	/**
+	*  Reads a cooked cache's index.
+	*  Any cache already mounted is dropped first.
+	*  @param [in] directory The directory holding the index and
+	*              blobs, including its trailing separator
+	*  @return true if the index was read and is valid
+	*/
+	bool mount(const std::string& directory);
+
+	/**
+	*  Drops the index.
+	*/
+	void unmount();
+
+	/**
+	*  Copies a cooked image's pixels out of its blob.
+	*  May be called from any thread.
+	*  @param [in] texture_file_name The game path of the image
+	*  @param [out] image The image's pixels, in the engine's format
+	*  @return true if the image is cooked and its blob is valid
+	*/
+	bool read(const std::string& texture_file_name, TexturePixels& image);
+
+	/**
+	*  Makes pixels the texture of a sprite. Call on the main thread.
+	*  The headless engine stores them under the image's game path,
+	*  which is how it implements setData, so any decoded image can be
+	*  installed. The real engine needs the image's cooked shell.
+	*  @param [in] sprite The sprite to bind to the texture
+	*  @param [in] image The pixels, from read or TextureCache::decode
+	*  @param [out] bound_file The path the engine now knows the texture by
+	*  @return true if the sprite shows the pixels
+	*/
+	bool install(ASGE::Sprite* sprite, const TexturePixels& image, std::string& bound_file);
+
+	/**
+	*  Returns the number of cooked images installed since the cache was mounted.
+	*/
+	unsigned int installed() const noexcept;
+
+	/**
+	*  Returns the pixel bytes copied from blobs since the cache was mounted.
+	*/
+	size_t installedBytes() const noexcept;
+
+private:
+	struct Entry
+	{
+		uint64_t source_hash = 0;
+		std::atomic<bool> installed{ false };
+	};
+
+	std::string directory;
+	std::unordered_map<std::string, Entry> entries;
+	std::atomic<unsigned int> installed_count{ 0 };
+	std::atomic<size_t> installed_bytes{ 0 };
+};
@@ -0,0 +1,63 @@
+#include "EntityStore.h"
+
+Entity EntityStore::create()
+{
+	Entity entity;
+	if (!free_slots.empty())
+	{
+		entity.index = free_slots.back();
+		free_slots.pop_back();
+	}
+	else
+	{
+		entity.index = static_cast<uint32_t>(generations.size());
+		generations.push_back(0);
+		alive.push_back(0);
+	}
+
+	entity.generation = generations[entity.index];
+	alive[entity.index] = 1;
+	alive_count++;
+	return entity;
+}
+
+/**
+*   @brief   Destroys an entity
+*   @details Its components are removed before the generation is
+             bumped, as the arrays check the handle's generation.
+*   @return  void
+*/
+void EntityStore::destroy(Entity entity)
+{
+	if (!isAlive(entity))
+	{
+		return;
+	}
+
+	for (ComponentStorage* storage : storages)
+	{
+		storage->remove(entity);
+	}
+
+	generations[entity.index]++;
+	alive[entity.index] = 0;
+	free_slots.push_back(entity.index);
+	alive_count--;
+}
+
+bool EntityStore::isAlive(Entity entity) const noexcept
+{
+	return entity.index < generations.size() &&
+		alive[entity.index] &&
+		generations[entity.index] == entity.generation;
+}
+
+size_t EntityStore::size() const noexcept
+{
+	return alive_count;
+}
+
+void EntityStore::registerComponents(ComponentStorage& storage)
+{
+	storages.push_back(&storage);
+}
@@ -0,0 +1,201 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+*  A handle to an entity.
+*  The index picks the entity's slot in the store and the generation
+*  tells apart the entities that have used that slot, so a handle kept
+*  after its entity is destroyed never reaches whatever replaced it.
+*/
+struct Entity
+{
+	static constexpr uint32_t INVALID = 0xFFFFFFFF;
+
+	uint32_t index = INVALID;
+	uint32_t generation = 0;
+
+	bool operator==(const Entity& rhs) const noexcept
+	{
+		return index == rhs.index && generation == rhs.generation;
+	}
+
+	bool operator!=(const Entity& rhs) const noexcept
+	{
+		return !(*this == rhs);
+	}
+};
+
+/**
+*  The part of a component array the store needs to see.
+*  Lets EntityStore::destroy remove an entity from every array it was
+*  registered with, whatever their component types.
+*/
+class ComponentStorage
+{
+public:
+	virtual ~ComponentStorage() = default;
+
+	/**
+	*  Removes an entity's component, if it has one.
+	*/
+	virtual void remove(Entity entity) = 0;
+};
+
+/**
+*  Every component of one type, packed together.
+*  Components live contiguously in a dense array that systems iterate
+*  directly, with a sparse table mapping entity indices to slots in it.
+*  Removing a component moves the last one into its slot, so the dense
+*  array never has holes but its order is not stable. Pointers and
+*  references into it are invalidated by add and remove.
+*/
+template <typename T>
+class ComponentArray : public ComponentStorage
+{
+public:
+
+	/**
+	*  Gives an entity a component, replacing any it already has.
+	*  @return The entity's component.
+	*/
+	T& add(Entity entity, const T& component = T())
+	{
+		if (T* existing = get(entity))
+		{
+			*existing = component;
+			return *existing;
+		}
+
+		if (entity.index >= slots.size())
+		{
+			slots.resize(entity.index + 1, Entity::INVALID);
+		}
+
+		slots[entity.index] = static_cast<uint32_t>(components.size());
+		components.push_back(component);
+		owners.push_back(entity);
+		return components.back();
+	}
+
+	void remove(Entity entity) override
+	{
+		if (!has(entity))
+		{
+			return;
+		}
+
+		const uint32_t slot = slots[entity.index];
+		const uint32_t last = static_cast<uint32_t>(components.size()) - 1;
+		if (slot != last)
+		{
+			components[slot] = components[last];
+			owners[slot] = owners[last];
+			slots[owners[slot].index] = slot;
+		}
+
+		components.pop_back();
+		owners.pop_back();
+		slots[entity.index] = Entity::INVALID;
+	}
+
+	/**
+	*  Returns an entity's component, or null if it has none.
+	*/
+	T* get(Entity entity) noexcept
+	{
+		return has(entity) ? &components[slots[entity.index]] : nullptr;
+	}
+
+	const T* get(Entity entity) const noexcept
+	{
+		return has(entity) ? &components[slots[entity.index]] : nullptr;
+	}
+
+	bool has(Entity entity) const noexcept
+	{
+		return entity.index < slots.size() &&
+			slots[entity.index] != Entity::INVALID &&
+			owners[slots[entity.index]].generation == entity.generation;
+	}
+
+	void reserve(size_t capacity)
+	{
+		components.reserve(capacity);
+		owners.reserve(capacity);
+	}
+
+	void clear() noexcept
+	{
+		components.clear();
+		owners.clear();
+		slots.clear();
+	}
+
+	size_t size() const noexcept { return components.size(); }
+
+	/**
+	*  Returns the component in a dense slot, in iteration order.
+	*/
+	T& operator[](size_t slot) noexcept { return components[slot]; }
+	const T& operator[](size_t slot) const noexcept { return components[slot]; }
+
+	/**
+	*  Returns the entity owning the component in a dense slot.
+	*/
+	Entity entity(size_t slot) const noexcept { return owners[slot]; }
+
+	T* begin() noexcept { return components.data(); }
+	T* end() noexcept { return components.data() + components.size(); }
+	const T* begin() const noexcept { return components.data(); }
+	const T* end() const noexcept { return components.data() + components.size(); }
+
+private:
+	std::vector<T> components;
+	std::vector<Entity> owners;
+	std::vector<uint32_t> slots;
+};
+
+/**
+*  Hands out entities and tracks which are alive.
+*  An entity is only an index and a generation; its data lives in the
+*  ComponentArrays, one per component type. Arrays registered with the
+*  store lose an entity's component when the entity is destroyed.
+*  Destroyed slots are reused, with their generation bumped.
+*/
+class EntityStore
+{
+public:
+
+	/**
+	*  Creates an entity with no components.
+	*/
+	Entity create();
+
+	/**
+	*  Destroys an entity and removes its components from the registered
+	*  arrays. Destroying a dead entity does nothing.
+	*/
+	void destroy(Entity entity);
+
+	bool isAlive(Entity entity) const noexcept;
+
+	/**
+	*  Returns the number of live entities.
+	*/
+	size_t size() const noexcept;
+
+	/**
+	*  Registers an array to be cleaned up by destroy.
+	*  The array must outlive the store or every entity in it.
+	*/
+	void registerComponents(ComponentStorage& storage);
+
+private:
+	std::vector<uint32_t> generations;
+	std::vector<uint8_t> alive;
+	std::vector<uint32_t> free_slots;
+	std::vector<ComponentStorage*> storages;
+	size_t alive_count = 0;
+};
@@ -0,0 +1,77 @@
+#include <cmath>
+#include "FixedTimestep.h"
+
+FixedTimestep::FixedTimestep(double tick_rate, int max_substeps) noexcept
+{
+	configure(tick_rate, max_substeps);
+}
+
+void FixedTimestep::configure(double tick_rate, int max_substeps) noexcept
+{
+	this->tick_rate = tick_rate > 0 ? tick_rate : 120.0;
+	this->max_substeps = max_substeps > 0 ? max_substeps : 1;
+	tick_length = 1.0 / this->tick_rate;
+	accumulator = 0;
+}
+
+/**
+*   @brief   Adds a frame's time to the accumulator.
+*   @details Spends the accumulator in whole ticks. If more ticks are
+             owed than max_substeps allows, the excess is dropped and
+             only the partial tick is kept for interpolation.
+*   @return  The number of ticks to run.
+*/
+int FixedTimestep::advance(double frame_seconds) noexcept
+{
+	if (frame_seconds > 0)
+	{
+		accumulator += frame_seconds;
+	}
+
+	int steps = 0;
+	while (accumulator >= tick_length && steps < max_substeps)
+	{
+		accumulator -= tick_length;
+		steps++;
+	}
+
+	if (accumulator >= tick_length)
+	{
+		const double partial = std::fmod(accumulator, tick_length);
+		dropped += accumulator - partial;
+		accumulator = partial;
+	}
+
+	tick_count += steps;
+	return steps;
+}
+
+double FixedTimestep::alpha() const noexcept
+{
+	return accumulator / tick_length;
+}
+
+double FixedTimestep::tickLength() const noexcept
+{
+	return tick_length;
+}
+
+double FixedTimestep::tickRate() const noexcept
+{
+	return tick_rate;
+}
+
+int FixedTimestep::maxSubsteps() const noexcept
+{
+	return max_substeps;
+}
+
+unsigned long long FixedTimestep::ticks() const noexcept
+{
+	return tick_count;
+}
+
+double FixedTimestep::droppedTime() const noexcept
+{
+	return dropped;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+/**
+*  Fixed rate simulation clock.
+*  Frame time is added to an accumulator which is then spent in ticks of
+*  a fixed length, so the simulation advances by the same amount each
+*  step regardless of the frame rate. The number of ticks run in a
+*  single frame is clamped; any time beyond the clamp is dropped so a
+*  long hitch slows the game down rather than stalling it while it
+*  catches up. What is left in the accumulator is exposed as a blend
+*  factor for interpolating the rendered positions.
+*/
+class FixedTimestep
+{
+public:
+
+	/**
+	*  Constructor.
+	*  @param [in] tick_rate Ticks per second.
+	*  @param [in] max_substeps The most ticks to run in one frame.
+	*/
+	FixedTimestep(double tick_rate = 120.0, int max_substeps = 8) noexcept;
+
+	/**
+	*  Changes the tick rate and clamp. Clears the accumulator.
+	*  @param [in] tick_rate Ticks per second.
+	*  @param [in] max_substeps The most ticks to run in one frame.
+	*/
+	void configure(double tick_rate, int max_substeps) noexcept;
+
+	/**
+	*  Adds a frame's elapsed time.
+	*  @param [in] frame_seconds The time since the last frame.
+	*  @return The number of ticks to run this frame.
+	*/
+	int advance(double frame_seconds) noexcept;
+
+	/**
+	*  Returns how far between the last two ticks the frame is.
+	*  @return 0 at the last tick, approaching 1 at the next.
+	*/
+	double alpha() const noexcept;
+
+	/**
+	*  Returns the length of a tick.
+	*  @return The tick length in seconds.
+	*/
+	double tickLength() const noexcept;
+
+	double tickRate() const noexcept;
+	int maxSubsteps() const noexcept;
+
+	/**
+	*  Returns the ticks run since construction.
+	*/
+	unsigned long long ticks() const noexcept;
+
+	/**
+	*  Returns the time dropped by the substep clamp.
+	*  @return The dropped time in seconds.
+	*/
+	double droppedTime() const noexcept;
+
+private:
+	double tick_rate = 120.0;
+	double tick_length = 1.0 / 120.0;
+	int max_substeps = 8;
+	double accumulator = 0;
+	double dropped = 0;
+	unsigned long long tick_count = 0;
+};
@@ -1,11 +1,20 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iterator>
 #include <string>
 
 #include <Engine/Keys.h>
 #include <Engine/Input.h>
 #include <Engine/InputEvents.h>
 #include <Engine/Sprite.h>
-#include <math.h.>
+#include <cmath>
 #include "Game.h"
+#include "SpritePool.h"
+#include "Sweep.h"
+#include "TextureCache.h"
 
 /**
 *   @brief   Default Constructor.
@@ -14,7 +23,7 @@ and even seeding the random number generator.
 */
 AngryBirdsGame::AngryBirdsGame()
 {
-	std::srand(time(NULL));
+	std::srand(static_cast<unsigned int>(std::time(NULL)));
 }
 
 /**
@@ -23,21 +32,32 @@ AngryBirdsGame::AngryBirdsGame()
 */
 AngryBirdsGame::~AngryBirdsGame()
 {
-	this->inputs->unregisterCallback(key_callback_id);
-	this->inputs->unregisterCallback(mouse_callback_id);
-	this->inputs->unregisterCallback(mouse_move_callback_id);
+	input_bus.unsubscribe(key_callback_id);
+	input_bus.unsubscribe(mouse_move_callback_id);
+	input_bus.disconnect();
+
+	if (!profile_dump.empty())
+	{
+		profiler.dumpCSV(profile_dump + ".csv");
+		profiler.dumpTrace(profile_dump + ".json");
+	}
+
+	//the cache outlives the renderer, so its textures go while it is still here
+	TextureCache::global().purge();
+	TextureCache::global().clear();
 }
 
 /**
 *   @brief   Initialises the game.
 *   @details The game window is created and all assets required to
-run the game are loaded. The keyHandler and clickHandler
-callback should also be set in the initialise function.
+run the game are loaded. The keyHandler and moveHandler
+are also subscribed to the input bus here.
 *   @return  True if the game initialised correctly.
 */
 #pragma region [initaliseFunctions]
 bool AngryBirdsGame::init()
 {
+	const auto init_start = Profiler::Clock::now();
 	setupResolution();
 	if (!initAPI())
 	{
@@ -48,19 +68,38 @@ bool AngryBirdsGame::init()
 	renderer->setWindowTitle("Castle Siege");
 	renderer->setWindowedMode(ASGE::Renderer::WindowMode::WINDOWED);
 	renderer->setClearColour(ASGE::COLOURS::BLACK);
-	inputs->use_threads = false;
+	renderer->setSpriteMode(ASGE::SpriteSortMode::DEFERRED);
+	inputs->use_threads = true;
 
 
-	key_callback_id = inputs->addCallbackFnc(
-		ASGE::E_KEY, &AngryBirdsGame::keyHandler, this);
+	//the engine's input thread queues events on the bus, they are handled
+	//at the start of update and the ticks read the bus's snapshot
+	input_bus.connect(inputs.get());
 
-	mouse_callback_id = inputs->addCallbackFnc(
-		ASGE::E_MOUSE_CLICK, &AngryBirdsGame::clickHandler, this);
+	key_callback_id = input_bus.subscribe<AngryBirdsGame, &AngryBirdsGame::keyHandler>(
+		ASGE::E_KEY, this);
 
-	mouse_move_callback_id = inputs->addCallbackFnc(
-		ASGE::E_MOUSE_MOVE, &AngryBirdsGame::moveHandler, this);
+	mouse_move_callback_id = input_bus.subscribe<AngryBirdsGame, &AngryBirdsGame::moveHandler>(
+		ASGE::E_MOUSE_MOVE, this);
+
+
+	//install images from the cooked cache rather than decoding them, when the build cooked one
+	TextureCache::global().mountCooked("Resources\\cooked\\");
+
+	//serve Resources/images from the baked atlas when the build made one
+	if (images_atlas.loadIndex(renderer.get(), "Resources\\atlas\\images.atlas"))
+	{
+		TextureCache::global().mount(&images_atlas, "Resources\\images\\");
+	}
 
+	//every sprite the game makes comes from the pool, so make them now
+	SpritePool::global().reserve(renderer.get(), 48);
+	if (!load_levels())
+	{
+		return false;
+	}
 
+	create_entities();
 	if (!loadSprites())
 	{
 		return false;
@@ -70,51 +109,274 @@ bool AngryBirdsGame::init()
 	{
 		return false;
 	}
+	startup_ms = std::chrono::duration<double, std::milli>(Profiler::Clock::now() - init_start).count();
+
+	//profile sections, CASTLE_SIEGE_PROFILE names files to dump on exit
+	profile_input = profiler.section("input");
+	profile_tick = profiler.section("tick");
+	profile_selection = profiler.section("selection");
+	profile_army = profiler.section("army");
+	profile_flight = profiler.section("flight");
+	profile_collision = profiler.section("collision");
+	profile_spawning = profiler.section("spawning");
+	profile_states = profiler.section("states");
+	profile_submit = profiler.section("submit");
+	profile_flush = profiler.section("flush");
+	profile_present = profiler.section("present");
+	profiler.setTracing(true);
+	if (const char* dump = std::getenv("CASTLE_SIEGE_PROFILE"))
+	{
+		profile_dump = dump;
+	}
 
+	//draw the moving sprites between simulation ticks
+	timestep.configure(tick_rate, max_substeps);
+	interpolator.track(army.spriteComponent()->getSprite());
+	for (const Renderable& renderable : renderables)
+	{
+		interpolator.track(renderable.sprite);
+	}
 
-	in_menu = true;
+	//each state's hooks, victory waits on the start button like an intro
+	states.add(STATE_MENU, { "menu", &AngryBirdsGame::enter_menu, nullptr,
+		&AngryBirdsGame::update_menu, &AngryBirdsGame::render_menu });
+	states.add(STATE_INTRO, { "intro", &AngryBirdsGame::enter_intro, nullptr,
+		&AngryBirdsGame::update_intro, &AngryBirdsGame::render_intro });
+	states.add(STATE_PLAYING, { "playing", &AngryBirdsGame::enter_playing, nullptr,
+		&AngryBirdsGame::update_playing, &AngryBirdsGame::render_level });
+	states.add(STATE_GAMEOVER, { "gameover", &AngryBirdsGame::enter_gameover, nullptr,
+		nullptr, &AngryBirdsGame::render_gameover });
+	states.add(STATE_VICTORY, { "victory", &AngryBirdsGame::enter_intro, nullptr,
+		&AngryBirdsGame::update_intro, &AngryBirdsGame::render_victory });
+	states.trace(profiler, profile_states);
+	states.start(STATE_MENU);
 
 	return true;
 }
 #pragma endregion
 
-//load buildings
-bool AngryBirdsGame::initalise_buildings()
+/**
+*   @brief   Maps the level pack
+*   @details Sizes the structures for the largest level and makes
+each material's image paths once, so switching level and
+reloading the structures never builds a string.
+*   @return  True if the pack loaded.
+*/
+bool AngryBirdsGame::load_levels()
+{
+	if (!levels.load("Resources\\levels\\levels.lvl") || !levels.levelCount())
+	{
+		return false;
+	}
+
+	const std::string images = "Resources\\images\\";
+	material_textures.clear();
+	material_damaged_textures.clear();
+	for (size_t m = 0; m < levels.materialCount(); m++)
+	{
+		const LevelFormat::Material& material = levels.material(m);
+		const char* damaged = levels.string(material.damaged_texture);
+		material_textures.push_back(images + levels.string(material.texture));
+		material_damaged_textures.push_back(damaged ? images + damaged : std::string());
+	}
+
+	structures.resize(levels.maxStructures());
+	return true;
+}
+
+/**
+*   @brief   Points the game at the current level
+*   @details The level's records are used where they are mapped,
+so this only swaps a pointer. Once a level is running the
+next one's images are streamed first, and the switch waits
+until they are resident so it never loads from disk.
+*   @return  True if the level changed.
+*/
+bool AngryBirdsGame::select_level()
+{
+	const LevelFormat::Level* selected = levels.level(current_level - 1);
+	if (!selected || selected == level)
+	{
+		return false;
+	}
+
+	if (level && stream_level(current_level) != AssetStreamer::Status::READY)
+	{
+		return false;
+	}
+
+	load_intro(current_level);
+	level = selected;
+	structure_count = static_cast<int>(level->structure_count);
+	max_lives = std::min<int>(level->projectiles, max_rocks);
+	return true;
+}
+
+/**
+*   @brief   Streams the images a level and its structures use
+*   @details Safe to call every tick, images already requested are
+not requested again. Levels past the last are ready. While
+any image is still loading the level is loading, after that
+it has failed if any image failed.
+*   @return  READY once every image is resident.
+*/
+AssetStreamer::Status AngryBirdsGame::stream_level(int level_number)
 {
-	//initalise buildings
-	for (int i = 0; i < max_buildings; i++)
+	const LevelFormat::Level* next = levels.level(level_number - 1);
+	if (!next)
+	{
+		return AssetStreamer::Status::READY;
+	}
+
+	bool loading = false;
+	bool failed = false;
+	auto request = [this, &loading, &failed](const std::string& image)
+	{
+		const AssetStreamer::Status status = streamer.request(image);
+		loading = loading || status == AssetStreamer::Status::LOADING;
+		failed = failed || status == AssetStreamer::Status::FAILED;
+	};
+
+	if (level_number <= intro_count)
 	{
-		//load brick sprite
-		std::string building1_layer = "Resources\\images\\building_brick1.png";
-		if (!building1[i].addSpriteComponent(renderer.get(), building1_layer))
+		request(intro_textures[level_number - 1]);
+	}
+
+	const LevelFormat::Structure* layout = levels.structures(*next);
+	for (uint32_t i = 0; i < next->structure_count; i++)
+	{
+		const uint16_t material = layout[i].material;
+		request(material_textures[material]);
+		if (!material_damaged_textures[material].empty())
 		{
-			return false;
+			request(material_damaged_textures[material]);
 		}
+	}
+
+	if (loading)
+	{
+		return AssetStreamer::Status::LOADING;
+	}
 
-		//load roof sprite
-		std::string building1_roof_layer = "Resources\\images\\building_brick1_roof.png";
-		building1_roof[i].addSpriteComponent(renderer.get(), building1_roof_layer);
+	return failed ? AssetStreamer::Status::FAILED : AssetStreamer::Status::READY;
+}
+
+/**
+*   @brief   Makes the sprite for a level's intro
+*   @details Only once its image is resident, so making it is a
+cache hit. Until then the intro is drawn without it.
+*   @return  void
+*/
+void AngryBirdsGame::load_intro(int level_number)
+{
+	if (level_number < 1 || level_number > intro_count || level_intro_sprites[level_number - 1])
+	{
+		return;
+	}
 
-		//set visibility to true
-		building1[i].visibility = true;
-		building1_roof[i].visibility = true;
+	const std::string& image = intro_textures[level_number - 1];
+	GameObject& intro = level_intros[level_number - 1];
+	if (TextureCache::global().isResident(image) && intro.addSpriteComponent(renderer.get(), image))
+	{
+		ASGE::Sprite* sprite = intro.spriteComponent()->getSprite();
+		sprite->xPos(game_width / 2 - 200);
+		sprite->yPos(100);
+		level_intro_sprites[level_number - 1] = sprite;
+	}
+}
 
-		//set col num to 0
-		building1_roof[1].col_num = 0;
+/**
+*   @brief   Loads the sprites of the current level's structures
+*   @details Structures keep their components between levels, so
+reloading a level that uses the same materials only resets
+each sprite to its intact state.
+*   @return  True if every sprite loaded.
+*/
+bool AngryBirdsGame::load_structures()
+{
+	const LevelFormat::Structure* layout = levels.structures(*level);
+	for (int i = 0; i < structure_count; i++)
+	{
+		const uint16_t material = layout[i].material;
+		if (!structures[i].addSpriteComponent(renderer.get(), material_textures[material]))
+		{
+			return false;
+		}
 
-		//get sprites
-		building1_sprite[i] = building1[i].spriteComponent()->getSprite();
-		building1_roof_sprite[i] = building1_roof[i].spriteComponent()->getSprite();
+		//load damaged sprite up front so a hit only swaps states
+		if (!material_damaged_textures[material].empty())
+		{
+			structures[i].addSpriteState(renderer.get(), STRUCTURE_DAMAGED, material_damaged_textures[material]);
+		}
 	}
 
-	reset_building_postiions();
+	colliders_dirty = true;
+	return true;
+}
+
+//load buildings
+bool AngryBirdsGame::initalise_buildings()
+{
+	select_level();
+	if (!load_structures())
+	{
+		return false;
+	}
 
+	//stand every structure back up
+	for (int i = 0; i < structure_count; i++)
+	{
+		Target& structure = structure_state(i);
+		structure.standing = true;
+		structure.hits = 0;
+	}
 
+	reset_building_postiions();
+	colliders_dirty = true;
+	return true;
 }
 
 //load sprites
 bool AngryBirdsGame::loadSprites()
 {
+	//decode every image the game starts with together, the sprites below are then cache hits,
+	//later levels' intros are streamed while the level before them is played
+	static const char* const startup_images[] = {
+		"Resources\\images\\menu_title.png",
+		"Resources\\images\\menu_start.png",
+		"Resources\\images\\menu_exit.png",
+		"Resources\\images\\gameover.png",
+		"Resources\\images\\okay.png",
+		"Resources\\images\\levels_complete.png",
+		"Resources\\images\\level_start.png",
+		"Resources\\images\\level1_intro.png",
+		"Resources\\images\\cursor.png",
+		"Resources\\images\\foreground.png",
+		"Resources\\images\\overlay.png",
+		"Resources\\images\\army.png",
+		"Resources\\images\\king.png",
+		"Resources\\images\\catapult.png",
+		"Resources\\images\\fire_limit.png",
+		"Resources\\images\\rock1.png" };
+	TextureBatch startup;
+	for (const char* image : startup_images)
+	{
+		startup.add(image);
+	}
+	for (size_t m = 0; m < material_textures.size(); m++)
+	{
+		startup.add(material_textures[m]);
+		if (!material_damaged_textures[m].empty())
+		{
+			startup.add(material_damaged_textures[m]);
+		}
+	}
+	startup.load(renderer.get());
+	if (startup.timing().files)
+	{
+		startup_textures = startup.timing();
+	}
+
 	//menu title
 	std::string menu_title_layer = "Resources\\images\\menu_title.png";
 	if (!menu_title.addSpriteComponent(renderer.get(), menu_title_layer))
@@ -165,25 +427,37 @@ bool AngryBirdsGame::loadSprites()
 	}
 
 	//level 1 intro
-	std::string level1_intro_layer = "Resources\\images\\level1_intro.png";
-	if (!level1_intro.addSpriteComponent(renderer.get(), level1_intro_layer))
-	{
-		return false;
-	}
-
-	//level 2 intro
-	std::string level2_intro_layer = "Resources\\images\\level2_intro.png";
-	if (!level2_intro.addSpriteComponent(renderer.get(), level2_intro_layer))
+	load_intro(1);
+	if (!level_intro_sprites[0])
 	{
 		return false;
 	}
 
-	//level 3 intro
-	std::string level3_intro_layer = "Resources\\images\\level3_intro.png";
-	if (!level3_intro.addSpriteComponent(renderer.get(), level3_intro_layer))
-	{
-		return false;
-	}
+	//the menu, intros and signs never move, so place them once
+	menu_title_sprite = menu_title.spriteComponent()->getSprite();
+	menu_start_sprite = menu_start.spriteComponent()->getSprite();
+	menu_exit_sprite = menu_exit.spriteComponent()->getSprite();
+	menu_title_sprite->xPos(game_width / 2 - 500);
+	menu_title_sprite->yPos(100);
+	menu_start_sprite->xPos(game_width / 2 - 230);
+	menu_start_sprite->yPos(350);
+	menu_exit_sprite->xPos(game_width / 2 - 230);
+	menu_exit_sprite->yPos(500);
+
+	level_start_sprite = level_start.spriteComponent()->getSprite();
+	level_start_sprite->xPos(game_width / 2 - 120);
+	level_start_sprite->yPos(480);
+
+	gameover_sign_sprite = gameover_sign.spriteComponent()->getSprite();
+	okay_sprite = okay.spriteComponent()->getSprite();
+	gameover_sign_sprite->xPos(game_width / 2 - 300);
+	gameover_sign_sprite->yPos(300);
+	okay_sprite->xPos(game_width / 2 - 265);
+	okay_sprite->yPos(470);
+
+	victory_sprite = victory.spriteComponent()->getSprite();
+	victory_sprite->xPos(game_width / 2 - 300);
+	victory_sprite->yPos(100);
 
 	//cursor
 	std::string cursor_layer = "Resources\\images\\cursor.png";
@@ -272,112 +546,52 @@ bool AngryBirdsGame::loadSprites()
 		}
 
 		//get sprite
-		rocks_sprite[i] = rocks[i].spriteComponent()->getSprite();
+		ASGE::Sprite* rock_sprite = rocks[i].spriteComponent()->getSprite();
+		renderables.get(rock_entities[i])->sprite = rock_sprite;
 
 		//assign position
-		rocks_sprite[i]->xPos(x_cord * 25);
-		rocks_sprite[i]->yPos(y_cord * 12);
+		Transform& transform = rock_transform(i);
+		transform.x = x_cord * 25;
+		transform.y = y_cord * 12;
+		transform.length = rock_sprite->width();
+		transform.height = rock_sprite->height();
 		x_cord++;
 
-		rocks[i].fired = false;
-		rocks[i].selected = false;
-		rocks[i].visibility = true;
+		Projectile& rock = rock_state(i);
+		rock.fired = false;
+		rock.selected = false;
+		rock.visible = true;
 	}
 
+	sync_sprites();
+
 	return true;
 }
 
 //reset all buidling's positions
 void AngryBirdsGame::reset_building_postiions()
 {
-	//level 1
-	if (level_1 == true)
+	//a new level may use other materials
+	if (select_level())
 	{
-		//set position
-		float x_cord = 5.5;
-		float y_cord = 2.6;
-		for (int i = 0; i < max_buildings; i++)
-		{
-			//get sprites
-			building1_sprite[i] = building1[i].spriteComponent()->getSprite();
-			building1_roof_sprite[i] = building1_roof[i].spriteComponent()->getSprite();
-
-			//assign house pos
-			building1_sprite[i]->xPos(x_cord * house_width);
-			building1_sprite[i]->yPos(y_cord * house_width);
-
-			//assign roof pos
-			building1_roof_sprite[i]->xPos(x_cord * house_width);
-			building1_roof_sprite[i]->yPos(y_cord * house_width);
-
-			x_cord++;
-			if (i == 1 || i == 16 || i == 24 || i == 32)
-			{
-				x_cord = 5.5;
-				y_cord = 1.8;
-			}
-		}
+		load_structures();
 	}
 
-	//level 2
-	if (level_2 == true)
+	if (!level)
 	{
-		//set position
-		float x_cord = 5.5;
-		float y_cord = 1.8;
-		for (int i = 0; i < max_buildings; i++)
-		{
-			//get sprites
-			building1_sprite[i] = building1[i].spriteComponent()->getSprite();
-			building1_roof_sprite[i] = building1_roof[i].spriteComponent()->getSprite();
-
-			//assign house pos
-			building1_sprite[i]->xPos(x_cord * house_width);
-			building1_sprite[i]->yPos(y_cord * house_width);
-
-			//assign roof pos
-			building1_roof_sprite[i]->xPos(x_cord * house_width);
-			building1_roof_sprite[i]->yPos(y_cord * house_width);
-
-			x_cord++;
-			if (i == 0 || i == 16 || i == 24 || i == 32)
-			{
-				x_cord = 4.5;
-				y_cord = 2.6;
-			}
-		}
+		return;
 	}
 
-	//level 3
-	if (level_3 == true)
+	const LevelFormat::Structure* layout = levels.structures(*level);
+	for (int i = 0; i < structure_count; i++)
 	{
-		//set position
-		float x_cord = 5.5;
-		float y_cord = 0.5;
-		for (int i = 0; i < max_buildings; i++)
-		{
-			//get sprites
-			building1_sprite[i] = building1[i].spriteComponent()->getSprite();
-			building1_roof_sprite[i] = building1_roof[i].spriteComponent()->getSprite();
-
-			//assign house pos
-			building1_sprite[i]->xPos(x_cord * house_width);
-			building1_sprite[i]->yPos(y_cord * house_width);
-
-			//assign roof pos
-			building1_roof_sprite[i]->xPos(x_cord * house_width);
-			building1_roof_sprite[i]->yPos(y_cord * house_width);
-
-			//x_cord++;
-			y_cord++;
-			if (i == 2)
-			{
-				x_cord = 4.5;
-				y_cord = 2.6;
-			}
-		}
+		ASGE::Sprite* sprite = structures[i].spriteComponent()->getSprite();
+		sprite->xPos(layout[i].x);
+		sprite->yPos(layout[i].y);
 	}
 
+	//knocked roofs go back on their walls
+	colliders_dirty = true;
 }
 
 //reset the rock positions
@@ -388,18 +602,19 @@ void AngryBirdsGame::reset_rock_postions()
 	int y_cord = 63;
 	for (int i = 0; i < max_rocks; i++)
 	{
-		//get sprite
-		rocks_sprite[i] = rocks[i].spriteComponent()->getSprite();
-
 		//assign position
-		rocks_sprite[i]->xPos(x_cord * 25);
-		rocks_sprite[i]->yPos(y_cord * 12);
+		Transform& transform = rock_transform(i);
+		transform.x = x_cord * 25;
+		transform.y = y_cord * 12;
 		x_cord++;
 
-		rocks[i].selected = false;
-		rocks[i].visibility = true;
+		Projectile& rock = rock_state(i);
+		rock.selected = false;
+		rock.visible = true;
 
 	}
+
+	sync_sprites();
 }
 
 //reset army positions
@@ -407,103 +622,126 @@ void AngryBirdsGame::reset_army_positions()
 {
 	army.visibility = true;
 	army_sprite = army.spriteComponent()->getSprite();
-	army_x_pos = army_sprite->xPos();
-	army_y_pos = army_sprite->yPos();
-	army_x_pos = 1200;
-	army_y_pos = 650;
+	army_x_pos = level ? level->army_x : 1200;
+	army_y_pos = level ? level->army_y : 650;
 	army_sprite->xPos(army_x_pos);
 	army_sprite->yPos(army_y_pos);
 }
 
 void AngryBirdsGame::initalise_rocks()
 {
+	static const std::string rock_layer = "Resources\\images\\rock1.png";
+
 	//rocks
 	int x_cord = 1;
 	int y_cord = 63;
 	for (int i = 0; i < max_rocks; i++)
 	{
 		//assign sprite to each block
-		rocks[i].addSpriteComponent(renderer.get(), "Resources\\images\\rock1.png");
-	
+		rocks[i].addSpriteComponent(renderer.get(), rock_layer);
 
 		//get sprite
-		rocks_sprite[i] = rocks[i].spriteComponent()->getSprite();
+		ASGE::Sprite* rock_sprite = rocks[i].spriteComponent()->getSprite();
+		renderables.get(rock_entities[i])->sprite = rock_sprite;
 
 		//assign position
-		rocks_sprite[i]->xPos(x_cord * 25);
-		rocks_sprite[i]->yPos(y_cord * 12);
+		Transform& transform = rock_transform(i);
+		transform.x = x_cord * 25;
+		transform.y = y_cord * 12;
+		transform.length = rock_sprite->width();
+		transform.height = rock_sprite->height();
 		x_cord++;
 
-		rocks[i].fired = false;
-		rocks[i].selected = false;
-		rocks[i].visibility = true;
+		Projectile& rock = rock_state(i);
+		rock.fired = false;
+		rock.selected = false;
+		rock.visible = true;
+	}
+
+	sync_sprites();
+
+}
+/**
+*   @brief   Creates the rock and structure entities
+*   @details Each rock gets a transform, projectile and renderable
+and each structure slot a target. The arrays are filled in
+creation order, so their dense slots line up with the rock
+and structure indices until an entity is destroyed.
+*   @return  void
+*/
+void AngryBirdsGame::create_entities()
+{
+	entities.registerComponents(transforms);
+	entities.registerComponents(projectiles);
+	entities.registerComponents(targets);
+	entities.registerComponents(renderables);
+	transforms.reserve(max_rocks);
+	projectiles.reserve(max_rocks);
+	renderables.reserve(max_rocks);
+	targets.reserve(structures.size());
+
+	for (int i = 0; i < max_rocks; i++)
+	{
+		rock_entities[i] = entities.create();
+		transforms.add(rock_entities[i]);
+		projectiles.add(rock_entities[i]);
+		renderables.add(rock_entities[i]);
+	}
+
+	structure_entities.resize(structures.size());
+	for (Entity& structure : structure_entities)
+	{
+		structure = entities.create();
+		targets.add(structure);
 	}
+}
+
+Projectile& AngryBirdsGame::rock_state(int i)
+{
+	return *projectiles.get(rock_entities[i]);
+}
+
+Transform& AngryBirdsGame::rock_transform(int i)
+{
+	return *transforms.get(rock_entities[i]);
+}
 
+Target& AngryBirdsGame::structure_state(int i)
+{
+	return *targets.get(structure_entities[i]);
 }
+
 //reset game states
 void AngryBirdsGame::reset_game_states()
 {
-	victory_bool == false;
-	in_menu = true;
-	level_1 = false;
-	level_1_intro_bool = true;
-	level_2 = false;
-	level_2_intro_bool = false;
-	level_3 = false;
-	level_3_intro_bool = false;
-	gameover = false;
 	freeze_cursor = false;
-	victory_bool = false;
 	current_level = 1;
-	level_reload = true;
 
-	for (int i = 0; i < max_buildings; i++)
+	for (size_t i = 0; i < structures.size(); i++)
 	{
 		//set visibility
-		building1_roof->visibility = true;
+		structure_state(static_cast<int>(i)).standing = true;
 		//reset collision numbers
-		building1_roof[i].col_num = 0;
+		structure_state(static_cast<int>(i)).hits = 0;
 	}
+
+	colliders_dirty = true;
 }
 
 void AngryBirdsGame::reset_king_positions()
 {
-	if (current_level == 1)
-	{
-		king.visibility = true;
-		king_sprite = king.spriteComponent()->getSprite();
-		king_x_pos = king_sprite->xPos();
-		king_y_pos = king_sprite->yPos();
-		king_x_pos = 1350;
-		king_y_pos = 500;
-		king_sprite->xPos(king_x_pos);
-		king_sprite->yPos(king_y_pos);
-	}
-
-	if (current_level == 2)
-	{
-		king.visibility = true;
-		king_sprite = king.spriteComponent()->getSprite();
-		king_x_pos = king_sprite->xPos();
-		king_y_pos = king_sprite->yPos();
-		king_x_pos = 1350;
-		king_y_pos = 650;
-		king_sprite->xPos(king_x_pos);
-		king_sprite->yPos(king_y_pos);
-	}
-
-	if (current_level == 3)
+	const LevelFormat::Level* king_level = levels.level(current_level - 1);
+	if (king_level)
 	{
 		king.visibility = true;
 		king_sprite = king.spriteComponent()->getSprite();
-		king_x_pos = king_sprite->xPos();
-		king_y_pos = king_sprite->yPos();
-		king_x_pos = 1150;
-		king_y_pos = 650;
+		king_x_pos = king_level->king_x;
+		king_y_pos = king_level->king_y;
 		king_sprite->xPos(king_x_pos);
 		king_sprite->yPos(king_y_pos);
 	}
 
+	colliders_dirty = true;
 }
 /**
 *   @brief   Sets the game window resolution
@@ -525,34 +763,24 @@ void AngryBirdsGame::setupResolution()
 
 /**
 *   @brief   Processes any key inputs
-*   @details This function is added as a callback to handle the game's
-keyboard input. For this game, calls to this function
-are thread safe, so you may alter the game's state as you
-see fit.
-*   @param   data The event data relating to key input.
-*   @see     KeyEvent
+*   @details This function is subscribed to the input bus to handle
+the game's keyboard input. The bus calls it from update,
+on the game's thread, so you may alter the game's state
+as you see fit.
+*   @param   key The event relating to key input.
+*   @see     InputEvent
 *   @return  void
 */
-void AngryBirdsGame::keyHandler(const ASGE::SharedEventData data)
+void AngryBirdsGame::keyHandler(const InputEvent& key)
 {
-	auto key = static_cast<const ASGE::KeyEvent*>(data.get());
-
-	if (key->key == ASGE::KEYS::KEY_ESCAPE)
+	if (key.key == ASGE::KEYS::KEY_ESCAPE)
 	{
-		reset_game_states();
-		reset_rock_postions();
-		initalise_buildings();
-		reset_building_postiions();
-		reset_army_positions();
-		begin = false;
-		loadSprites();
-		distance = 0;
-		spawner = true;
+		states.change(STATE_MENU);
 	}
 
-	else if (key->key == ASGE::KEYS::KEY_ENTER &&
-		key->action == ASGE::KEYS::KEY_PRESSED &&
-		key->mods == 0x0004)
+	else if (key.key == ASGE::KEYS::KEY_ENTER &&
+		key.action == ASGE::KEYS::KEY_PRESSED &&
+		key.mods == 0x0004)
 	{
 		if (renderer->getWindowMode() == ASGE::Renderer::WindowMode::WINDOWED)
 		{
@@ -564,601 +792,973 @@ void AngryBirdsGame::keyHandler(const ASGE::SharedEventData data)
 		}
 	}
 
-	else if (in_menu)
+	else if (key.key == ASGE::KEYS::KEY_P &&
+		key.action == ASGE::KEYS::KEY_PRESSED)
 	{
-		if (key->key == ASGE::KEYS::KEY_SPACE)
-		{
-			in_menu = !in_menu;
-		}
+		show_profile = !show_profile;
+	}
+
+	else if (key.key == ASGE::KEYS::KEY_O &&
+		key.action == ASGE::KEYS::KEY_PRESSED)
+	{
+		profiler.dumpCSV("profile.csv");
+		profiler.dumpTrace("profile.json");
 	}
 }
 
+//cursor movement
+void AngryBirdsGame::moveHandler(const InputEvent&)
+{
+	inputs->setCursorMode(ASGE::CursorMode::HIDDEN);
+}
+
+
 /**
-*   @brief   Processes any click inputs
-*   @details This function is added as a callback to handle the game's
-mouse button input. For this game, calls to this function
-are thread safe, so you may alter the game's state as you
-see fit.
-*   @param   data The event data relating to key input.
-*   @see     ClickEvent
+*   @brief   Updates the scene
+*   @details Adds the frame's time to the fixed timestep and runs
+the ticks it is owed. Positions are captured before the
+last tick so render can draw between the last two ticks.
 *   @return  void
 */
-void AngryBirdsGame::clickHandler(const ASGE::SharedEventData data)
+void AngryBirdsGame::update(const ASGE::GameTime& us)
 {
-	auto click = static_cast<const ASGE::ClickEvent*>(data.get());
-	double cursor_x_pos, cursor_y_pos;
-	inputs->getCursorPos(cursor_x_pos, cursor_y_pos);
+	//everything between the last render and now is the engine's
+	//endFrame, swapBuffers and beginFrame
+	const auto frame_start = Profiler::Clock::now();
+	if (rendered)
+	{
+		profiler.add(profile_present, render_end, frame_start);
+	}
+	profiler.beginFrame();
 
-	//left mouse down
-	if (click->button == 0)
+	//input handlers run here, on the game's thread, before the frame's ticks
 	{
-		leftMouseDown = true;
+		Profiler::Scope scope(profiler, profile_input);
+		input_bus.dispatch();
 	}
 
+	//finished background loads become textures a few per frame
+	streamer.upload(renderer.get(), uploads_per_frame);
 
-	//right mouse down
-	if (click->button == 1)
+	const int steps = timestep.advance(us.delta_time.count() / 1000.0);
+	for (int step = 0; step < steps; step++)
 	{
-		rightMosueDown = true;
+		if (step == steps - 1)
+		{
+			interpolator.capture();
+		}
+
+		tick(timestep.tickLength());
 	}
+}
 
-	//no action
-	if (click->action == false)
+/**
+*   @brief   Advances the simulation by one fixed step
+*   @details Called by update at tick_rate, so movement does not
+depend on the frame rate. dt_sec is always the tick length.
+*   @return  void
+*/
+void AngryBirdsGame::tick(double dt_sec)
+{
+	Profiler::Scope scope(profiler, profile_tick);
+
+	//the input dispatched since the last tick, a click that came and
+	//went before this tick still counts as held for it
+	const InputSnapshot& input = input_bus.snapshot();
+	cursor_x = input.cursor_x;
+	cursor_y = input.cursor_y;
+	leftMouseDown = input.down(0);
+	rightMosueDown = input.down(1);
+	//assign custom cursor 
+	cursor_sprite = cursor.spriteComponent()->getSprite();
+	if (freeze_cursor == false)
 	{
-		leftMouseDown = false;
-		rightMosueDown = false;
+		cursor_sprite->xPos(cursor_x);
+		cursor_sprite->yPos(cursor_y);
 	}
 
+	//test the cursor against every button at once
+	button_boxes.clear();
+	button_boxes.add(menu_start.spriteComponent()->getBoundingBox());
+	button_boxes.add(menu_exit.spriteComponent()->getBoundingBox());
+	button_boxes.add(level_start.spriteComponent()->getBoundingBox());
+	button_boxes.overlaps(cursor.spriteComponent()->getBoundingBox(), buttons_under_cursor);
 
+	//changes asked for since the last tick happen first
+	states.update(dt_sec);
+
+	//sprites only ever show where a whole tick left the rocks
+	sync_sprites();
+	input_bus.endTick();
 }
 
-//cursor movement
-void AngryBirdsGame::moveHandler(const ASGE::SharedEventData data)
+/**
+*   @brief   Resets the game for a new run from the menu
+*   @details Runs once on entering the menu, from startup or when
+escape is pressed.
+*   @return  void
+*/
+void AngryBirdsGame::enter_menu()
 {
-	auto move = static_cast<const ASGE::MoveEvent*>(data.get());
-	inputs->setCursorMode(ASGE::CursorMode::HIDDEN);
+	reset_game_states();
+	reset_rock_postions();
+	reset_army_positions();
+	distance = 0;
+	spawner = true;
+
+	//reset score
+	player_score = 0;
+
+	//reset rocks
+	for (Projectile& rock : projectiles)
+	{
+		rock.fired = false;
+	}
 }
 
+void AngryBirdsGame::update_menu(double)
+{
+	//start
+	if (RectBatch::isSet(buttons_under_cursor, BUTTON_START) && leftMouseDown == true)
+	{
+		states.change(STATE_INTRO);
+	}
+
+	//exit
+	if (RectBatch::isSet(buttons_under_cursor, BUTTON_EXIT) && leftMouseDown == true)
+	{
+		signalExit();
+	}
+
+	if (input_bus.snapshot().keyPressed(ASGE::KEYS::KEY_SPACE))
+	{
+		states.change(STATE_INTRO);
+	}
+}
 
 /**
-*   @brief   Updates the scene
-*   @details Prepares the renderer subsystem before drawing the
-current frame. Once the current frame is has finished
-the buffers are swapped accordingly and the image shown.
+*   @brief   Shows the current level's layout behind its intro
+*   @details The level's images were requested while the level
+before it was played. If they are still streaming, the
+level is swapped in once every one of them is resident.
+If any failed, the start button retries them instead.
 *   @return  void
 */
-void AngryBirdsGame::update(const ASGE::GameTime& us)
+void AngryBirdsGame::enter_intro()
 {
-	auto dt_sec = us.delta_time.count() / 1000.0;
-	float distance = 0;
-	double cursor_x_pos, cursor_y_pos;
-	inputs->getCursorPos(cursor_x_pos, cursor_y_pos);
-	static bool initialized;
-	//assign custom cursor 
-	cursor_sprite = cursor.spriteComponent()->getSprite();
-	if (freeze_cursor == false)
+	reset_building_postiions();
+}
+
+void AngryBirdsGame::update_intro(double)
+{
+	//the level's images are all resident, swap it in
+	if (level != levels.level(current_level - 1))
 	{
-		cursor_sprite->xPos(cursor_x_pos);
-		cursor_sprite->yPos(cursor_y_pos);
+		level_status = stream_level(current_level);
+		if (level_status == AssetStreamer::Status::READY)
+		{
+			reset_building_postiions();
+		}
 	}
 
-
-	if (in_menu)
+	if (RectBatch::isSet(buttons_under_cursor, BUTTON_LEVEL) && leftMouseDown == true)
 	{
-		//start
-		if (menu_start.spriteComponent()->getBoundingBox().isInside(cursor.spriteComponent()->getBoundingBox()) && leftMouseDown == true)
+		if (level == levels.level(current_level - 1))
 		{
-			in_menu = false;
+			states.change(STATE_PLAYING);
 		}
-
-		//exit
-		if (menu_exit.spriteComponent()->getBoundingBox().isInside(cursor.spriteComponent()->getBoundingBox()) && leftMouseDown == true)
+		else if (level_status == AssetStreamer::Status::FAILED)
 		{
-			signalExit();
+			streamer.retry();
 		}
+	}
+}
+
+/**
+*   @brief   Sets the current level up to be played
+*   @return  void
+*/
+void AngryBirdsGame::enter_playing()
+{
+	//the next level's images load in the background while this one is played
+	stream_level(current_level + 1);
+
+	current_lives = max_lives;
+	initalise_buildings();
+	initalise_rocks();
+	reset_rock_postions();
+	reset_king_positions();
+	reset_army_positions();
+	king.visibility = true;
+}
 
+/**
+*   @brief   Runs the game's systems
+*   @details Each system runs once per tick over the objects it owns.
+*   @return  void
+*/
+void AngryBirdsGame::update_playing(double dt_sec)
+{
+	update_selection(cursor_x, cursor_y);
+	update_army(dt_sec);
+	update_rock_flight(dt_sec, cursor_y);
+	update_collisions();
+	update_spawning();
+
+	//out of rocks, unless the last one won the level
+	if (current_lives == 0 && !states.changing())
+	{
+		states.change(STATE_GAMEOVER);
 	}
+}
 
-	if (!in_menu)
+/**
+*   @brief   Ends the run
+*   @details Saves the high score and puts the level back as it
+started, once, behind the game over sign.
+*   @return  void
+*/
+void AngryBirdsGame::enter_gameover()
+{
+	//save high score
+	if (player_score > high_score)
+	{
+		high_score = player_score;
+	}
+
+	reset_king_positions();
+	freeze_cursor = false;
+	reset_army_positions();
+	current_lives = max_lives;
+	reset_rock_postions();
+	initalise_buildings();
+}
+
+
+/**
+*   @brief   Selects and aims rocks with the cursor
+*   @details A rock under the cursor is picked up while the left
+mouse button is held and fired once it is released. The
+distance from the catapult to the cursor sets the power.
+*   @return  void
+*/
+void AngryBirdsGame::update_selection(double cursor_x_pos, double cursor_y_pos)
+{
+	Profiler::Scope scope(profiler, profile_selection);
+	rock_boxes.clear();
+	for (size_t k = 0; k < projectiles.size(); k++)
 	{
-		//level 1 intro
-		if (current_level == 1)
+		rock_boxes.add(transforms.get(projectiles.entity(k))->bounds());
+	}
+	rock_boxes.overlaps(cursor.spriteComponent()->getBoundingBox(), rocks_under_cursor);
+
+	for (size_t k = 0; k < projectiles.size(); k++)
+	{
+		//cursor selecting rock
+		Projectile& rock = projectiles[k];
+		if (rock.visible == true && leftMouseDown == true && rock.fired == false && freeze_cursor == false && RectBatch::isSet(rocks_under_cursor, k))
 		{
-			level_1 = true;
-			level_2 = false;
-			level_3 = false;
-			reset_building_postiions();
+			Transform& transform = *transforms.get(projectiles.entity(k));
+			if (number_selected < 1)
+			{
+				number_selected = 1;
+				rock.selected = true;
+			}
 
-			if (level_start.spriteComponent()->getBoundingBox().isInside(cursor.spriteComponent()->getBoundingBox()) && leftMouseDown == true)
+			if (transform.x > 250)
 			{
-				current_lives = max_lives;
-				initalise_buildings();
-				initalise_rocks();
+				rock.selected = false;
 				reset_rock_postions();
-				reset_king_positions();
-				king.visibility = true;
-				level_reload = false;
-				level_1_intro_bool = false;
-				begin = true;
 			}
+			if (rock.selected == true)
+			{
+				fire = false;
+				initialise_fire = true;
+				transform.x = static_cast<float>(cursor_x_pos - 15);
+				transform.y = static_cast<float>(cursor_y_pos - 15);
+				calculate_distance = true;
+			}
+		}
+	}
+
+	//once player has released lmb enable fire
+	if (leftMouseDown == false && initialise_fire == true)
+	{
+		fire = true;
+		number_selected = 0;
+	}
+
+	//calculate distance
+	distance = 0;
+	if (calculate_distance == true)
+	{
+		//distance calculations
+		double a_x = cursor_sprite->xPos();
+		double a_y = cursor_sprite->yPos();
+		double b_x = catapult_x_pos + 136;
+		double b_y = catapult_sprite->yPos();
+		double difference_x = a_x - b_x;
+		double difference_y = a_y - b_y;
+
+		//save result to distance
+		distance = std::sqrt((difference_x * difference_x) + (difference_y * difference_y));
+	}
+}
+
+/**
+*   @brief   Marches the army towards the catapult
+*   @details The game is lost once the army reaches it.
+*   @return  void
+*/
+void AngryBirdsGame::update_army(double dt_sec)
+{
+	Profiler::Scope scope(profiler, profile_army);
+
+	//army movment
+	army_x_pos -= min_speed * dt_sec;
+	army_sprite->xPos(army_x_pos);
+
+	//grab catapult x pos
+	catapult_x_pos = catapult_sprite->xPos();
+	if (army_x_pos < catapult_x_pos)
+	{
+		states.change(STATE_GAMEOVER);
+	}
+}
+
+/**
+*   @brief   Moves the fired rock along its curve
+*   @return  void
+*/
+void AngryBirdsGame::update_rock_flight(double dt_sec, double cursor_y_pos)
+{
+	Profiler::Scope scope(profiler, profile_flight);
+
+	//collisions sweep each rock back over the distance it flew this tick,
+	//and rocks leave the world once they are spent or put down
+	for (Projectile& rock : projectiles)
+	{
+		rock.moved_x = 0;
+		rock.moved_y = 0;
+		if (rock.body >= 0 && (fire == false || rock.visible == false || rock.selected == false))
+		{
+			physics.removeBody(rock.body);
+			rock.body = -1;
 		}
+	}
 
-		//level 1 intro
-		if (current_level == 2)
+	for (size_t k = 0; k < projectiles.size() && fire == true && distance > 0; k++)
+	{
+		//if fire = true & a rock is visable fire that rock
+		Projectile& rock = projectiles[k];
+		if (rock.visible == true && rock.selected == true)
 		{
-			level_1 = false;
-			level_2 = true;
-			level_3 = false;
-			reset_building_postiions();
+			//freeze cursor to prevent constant update while rock is in motion
+			freeze_cursor = true;
 
-			if (level_start.spriteComponent()->getBoundingBox().isInside(cursor.spriteComponent()->getBoundingBox()) && leftMouseDown == true)
+			if (rock.body < 0)
 			{
-				current_lives = max_lives;
-				initalise_buildings();
-				initalise_rocks();
-				reset_rock_postions();
-				reset_king_positions();
-				king.visibility = true;
-				level_reload = false;
-				level_2_intro_bool = false;
-				begin = true;
+				launch_rock(projectiles.entity(k), dt_sec, cursor_y_pos);
 			}
 		}
+	}
 
-		//level 1 intro
-		if (current_level == 3)
+	//knocked roofs keep sliding and falling between shots
+	physics.step(static_cast<float>(dt_sec));
+	update_structure_bodies();
+
+	for (size_t k = 0; k < projectiles.size(); k++)
+	{
+		Projectile& rock = projectiles[k];
+		if (rock.body >= 0)
 		{
-			level_1 = false;
-			level_2 = false;
-			level_3 = true;
-			reset_building_postiions();
+			//save distance
+			Transform& transform = *transforms.get(projectiles.entity(k));
+			const rect body = physics.bounds(rock.body);
+			rock.moved_x = body.x - transform.x;
+			rock.moved_y = body.y - transform.y;
+			transform.x = body.x;
+			transform.y = body.y;
+		}
+	}
+}
 
+/**
+*   @brief   Adds a fired rock to the physics world
+*   @details The launch follows the old closed form arc,
+y = a * (x - 600)^2 / distance, with x advancing at
+distance * 3 a second. That arc's gravity grows with the
+distance, so it is applied as the rock's gravity scale.
+Launching half a tick's gravity early makes the stepped
+flight land exactly on the arc at every tick.
+*   @return  void
+*/
+void AngryBirdsGame::launch_rock(Entity rock_entity, double dt_sec, double cursor_y_pos)
+{
+	const Transform& transform = *transforms.get(rock_entity);
+
+	//curve intensity
+	const float a = 0.25f;
+	const float d = static_cast<float>(distance);
+	const float rock_x = transform.x;
+	const float speed_x = d * 3;
+	const float arc_gravity = 2 * a * speed_x * speed_x / d;
+
+	PhysicsWorld::BodyDef rock;
+	rock.bounds = transform.bounds();
+	rock.bounds.y = a * (rock_x - 600) * (rock_x - 600) / d + static_cast<float>(cursor_y_pos * dt_sec);
+	rock.mass = rock_mass;
+	rock.gravity_scale = arc_gravity / physics.gravity;
+	//rocks are swept against the colliders instead of touching bodies
+	rock.category = BODY_ROCKS;
+	rock.mask = 0;
+	rock.velocity_x = speed_x;
+	rock.velocity_y = 2 * a * (rock_x - 600) / d * speed_x - 0.5f * arc_gravity * static_cast<float>(dt_sec);
+	projectiles.get(rock_entity)->body = physics.addBody(rock);
+}
+
+/**
+*   @brief   Resolves rocks hitting roofs, the king or the ground
+*   @details Roofs are damaged on the first hit and destroyed on
+the second, and each hit knocks the roof with the rock's
+momentum. Hitting the king completes the level and a
+rock landing off screen costs a life. Each rock only tests
+the roofs and king sharing its cells in the collider grid,
+and is swept over the tick's flight so only the first one it
+reaches is hit, however far it moved.
+*   @return  void
+*/
+void AngryBirdsGame::update_collisions()
+{
+	Profiler::Scope scope(profiler, profile_collision);
+	if (colliders_dirty)
+	{
+		rebuild_structure_bodies();
+		rebuild_colliders();
+	}
 
-			if (level_start.spriteComponent()->getBoundingBox().isInside(cursor.spriteComponent()->getBoundingBox()) && leftMouseDown == true)
+	const int king_collider = static_cast<int>(structures.size());
+	for (size_t k = 0; k < projectiles.size(); k++)
+	{
+		Projectile& rock = projectiles[k];
+		Transform& transform = *transforms.get(projectiles.entity(k));
+
+		//sweep the rock over this tick's flight so it cannot pass through a roof
+		rect rock_box = transform.bounds();
+		const float dx = rock.moved_x;
+		const float dy = rock.moved_y;
+		rock_box.x -= dx;
+		rock_box.y -= dy;
+		colliders.query(Sweep::bounds(rock_box, dx, dy), collider_hits);
+
+		//only the first thing the rock touches is hit
+		int hit = -1;
+		float hit_time = 0;
+		for (int j : collider_hits)
+		{
+			float toi = 0;
+			const bool standing = j < king_collider ? structure_state(j).standing : king.visibility;
+			if (standing && Sweep::timeOfImpact(rock_box, dx, dy, colliders.bounds(j), toi) && (hit < 0 || toi < hit_time))
 			{
-				current_lives = max_lives;
-				initalise_buildings();
-				initalise_rocks();
-				reset_rock_postions();
-				reset_king_positions();
-				king.visibility = true;
-				level_reload = false;
-				level_3_intro_bool = false;
-				begin = true;
+				hit = j;
+				hit_time = toi;
 			}
 		}
 
+		if (hit >= 0)
+		{
+			transform.x = rock_box.x + dx * hit_time;
+			transform.y = rock_box.y + dy * hit_time;
+		}
 
-		if (begin == true)
+		//structure collision
+		if (hit >= 0 && hit < king_collider)
 		{
-			//level 1
-			for (int i = 0; i < max_rocks; i++)
+			const int j = hit;
+			Target& structure = structure_state(j);
+			const LevelFormat::Material& material = levels.material(levels.structures(*level)[j].material);
+			//add to the structure's collision number
+			structure.hits++;
+
+			player_score += material.score;
+
+			//the rock's momentum knocks the roof, which may slide or fall off its walls
+			if (structure.body >= 0 && rock.body >= 0)
+			{
+				physics.applyImpulse(structure.body,
+					physics.velocityX(rock.body) * rock_mass,
+					physics.velocityY(rock.body) * rock_mass);
+			}
+
+			//switch to the damaged sprite until the material's hit points are used up
+			if (structure.hits < material.hit_points)
 			{
-				if (gameover == false)
+				if (material.damaged_texture != LevelFormat::NO_STRING)
 				{
-					//army movment
-					army_x_pos -= min_speed * dt_sec;
-					army_sprite->xPos(army_x_pos);
-
-					//grab catapult x pos
-					catapult_x_pos = catapult_sprite->xPos();
-					if (army_x_pos < catapult_x_pos)
-					{
-						gameover = true;
-					}
-
-
-					//grab y & x pos
-					float rock_y_pos = rocks_sprite[i]->yPos();
-					float rock_x_pos = rocks_sprite[i]->xPos();
-
-					for (int j = 0; j < max_buildings; j++)
-					{
-						//building 1 collision
-						if (rocks[i].spriteComponent()->getBoundingBox().isInside(building1_roof[j].spriteComponent()->getBoundingBox()) && building1_roof[j].visibility == true)
-						{
-							//add to the roof's collision number
-							building1_roof[j].col_num++;
-
-							player_score += 5;
-
-							//assign damaged roof sprite if the object has been collided with less than 1 time
-							if (building1_roof[j].col_num <= 1)
-							{
-								std::string building1_roof_layer = "Resources\\images\\building_brick1_roof_dmg.png";
-								building1_roof[j].addSpriteComponent(renderer.get(), building1_roof_layer);
-								reset_building_postiions();
-							}
-
-							//else destroy the object
-							else
-							{
-								building1_roof[j].visibility = false;
-							}
-
-							//set values accordingly
-							current_lives--;
-							rocks[i].fired = true;
-							rocks[i].visibility = false;
-							spawner = true;
-							initialise_fire = false;
-							fire = false;
-						}
-					}
-
-					//king collision
-					if (rocks[i].spriteComponent()->getBoundingBox().isInside(king.spriteComponent()->getBoundingBox()) && king.visibility == true)
-					{
-						//save high score
-						if (player_score > high_score)
-						{
-							high_score = player_score;
-						}
-
-						reset_king_positions();
-						king.visibility = false;
-						//victory_bool = true;
-						//level
-						if (current_level == 0)
-						{
-							level_1_intro_bool = true;
-						}
-						if (current_level == 1)
-						{
-							level_2_intro_bool = true;
-						}
-						if (current_level == 2)
-						{
-							level_3_intro_bool = true;
-						}
-						if (current_level < 3)
-						{
-							current_level++;
-						}
-
-						else if (current_level == 3)
-						{
-							victory_bool = true;
-							current_level = 1;
-						}
-						//set values accordingly
-						begin = false;
-						player_score = +35;
-						current_lives--;
-						rocks[i].fired = true;
-						rocks[i].visibility = false;
-						spawner = true;
-						initialise_fire = false;
-						fire = false;
-					}
-
-					//cursor selecting rock
-					if (rocks[i].spriteComponent()->getBoundingBox().isInside(cursor.spriteComponent()->getBoundingBox()) && rocks[i].visibility == true && leftMouseDown == true && rocks[i].fired == false && freeze_cursor == false)
-					{
-						if (number_selected < 1)
-						{
-							number_selected = 1;
-							rocks[i].selected = true;
-						}
-
-						if (rocks_sprite[i]->xPos() > 250)
-						{
-							rocks[i].selected = false;
-							reset_rock_postions();
-						}
-						if (rocks[i].selected == true)
-						{
-							fire = false;
-							initialise_fire = true;
-							rocks_sprite[i]->xPos(cursor_x_pos - 15);
-							rocks_sprite[i]->yPos(cursor_y_pos - 15);
-							calculate_distance = true;
-						}
-
-					}
-
-					//once player has released lmb enable fire
-					if (leftMouseDown == false && initialise_fire == true)
-					{
-						fire = true;
-						number_selected = 0;
-					}
-
-					//calculate distance
-					if (calculate_distance == true)
-					{
-						//distance calculations
-						double a_x = cursor_sprite->xPos();
-						double a_y = cursor_sprite->yPos();
-						double b_x = catapult_x_pos + 136;
-						double b_y = catapult_sprite->yPos();
-						double difference_x = a_x - b_x;
-						double difference_y = a_y - b_y;
-
-						//save result to distance
-						distance = std::sqrt((difference_x * difference_x) + (difference_y * difference_y));
-					}
-
-					//if fire = true & a rock is visable fire that rock
-					if (fire == true && rocks[i].visibility == true && rocks[i].selected == true && gameover == false)
-					{
-						//freeze cursor to prevent constant update while rock is in motion
-						freeze_cursor = true;
-
-						//grab x & y pos of rock
-						float rock_y_pos = rocks_sprite[i]->yPos();
-						float rock_x_pos = rocks_sprite[i]->xPos();
-
-						//curve intensity
-						float a = 0.25;
-						//enable x movement
-						rock_x_pos += distance * 3 * dt_sec;
-						//calculate curve
-						rock_y_pos = a * (rock_x_pos - 600)* (rock_x_pos - 600) / distance - (cursor_y_pos*-1) * dt_sec;
-
-						//save distance
-						rocks_sprite[i]->yPos(rock_y_pos);
-						rocks_sprite[i]->xPos(rock_x_pos);
-
-						//old equation: rock_y_pos = (a * (rock_x_pos - 800)*(rock_x_pos - 800)) / distance + -300;
-					}
-
-					//if rock is greater than game height
-					if (rock_y_pos > game_height && rock_x_pos > 300)
-					{
-						rocks[i].selected = false;
-						//boost x pos of army
-						army_x_pos -= 100;
-						army_sprite->xPos(army_x_pos);
-
-						//deduct life
-						current_lives--;
-
-						//reset rock
-						rocks[i].fired = true;
-						correct_distance = false;
-						rocks[i].visibility = false;
-						spawner = true;
-						initialise_fire = false;
-						fire = false;
-					}
-
-					//spawner
-					if (spawner == true)
-					{
-						freeze_cursor = false;
-						spawn = +1;
-						rocks[spawn].visibility = true;
-						reset_rock_postions();
-						spawner = false;
-					}
+					structures[j].spriteComponent()->setState(STRUCTURE_DAMAGED);
 				}
+			}
+
+			//else destroy the object
+			else
+			{
+				structure.standing = false;
+				colliders.remove(j);
+			}
+
+			//set values accordingly
+			current_lives--;
+			rock.fired = true;
+			rock.visible = false;
+			spawner = true;
+			initialise_fire = false;
+			fire = false;
+		}
+
+		//king collision
+		if (hit == king_collider)
+		{
+			//save high score
+			if (player_score > high_score)
+			{
+				high_score = player_score;
+			}
 
+			reset_king_positions();
+			king.visibility = false;
+			//level
+			if (current_level < 3)
+			{
+				current_level++;
+				states.change(STATE_INTRO);
 			}
 
-			//game over
-			if (current_lives == 0)
+			else if (current_level == 3)
 			{
-				//save high score
-				if (player_score > high_score)
+				current_level = 1;
+				states.change(STATE_VICTORY);
+			}
+			//set values accordingly
+			player_score = +35;
+			current_lives--;
+			rock.fired = true;
+			rock.visible = false;
+			spawner = true;
+			initialise_fire = false;
+			fire = false;
+		}
+
+		//if rock is greater than game height
+		if (transform.y > game_height && transform.x > 300)
+		{
+			rock.selected = false;
+			//boost x pos of army
+			army_x_pos -= 100;
+			army_sprite->xPos(army_x_pos);
+
+			//deduct life
+			current_lives--;
+
+			//reset rock
+			rock.fired = true;
+			correct_distance = false;
+			rock.visible = false;
+			spawner = true;
+			initialise_fire = false;
+			fire = false;
+		}
+	}
+}
+
+/**
+*   @brief   Refills the collider grid with the standing structures and king
+*   @details Called when a level is set up rather than every tick, as
+the structures and king only move between levels. Materials
+with no hit points, such as the brick houses, are scenery
+and are not added.
+*   @return  void
+*/
+void AngryBirdsGame::rebuild_colliders()
+{
+	colliders.clear();
+	const LevelFormat::Structure* layout = level ? levels.structures(*level) : nullptr;
+	for (int j = 0; j < structure_count; j++)
+	{
+		if (levels.material(layout[j].material).hit_points > 0 && structure_state(j).standing == true)
+		{
+			colliders.insert(j, structures[j].spriteComponent()->getBoundingBox());
+		}
+	}
+
+	if (king.visibility == true)
+	{
+		colliders.insert(static_cast<int>(structures.size()), king.spriteComponent()->getBoundingBox());
+	}
+
+	colliders_dirty = false;
+}
+
+/**
+*   @brief   Puts the level's structures into the physics world
+*   @details Roofs are dynamic bodies, added asleep so they stay put
+until a rock knocks them. The brick houses are scenery and
+only their wall tops are added, as static ledges under the
+roofs. Whole houses would not do, as each one's foot overlaps
+the roof of the house stacked below it.
+*   @return  void
+*/
+void AngryBirdsGame::rebuild_structure_bodies()
+{
+	for (size_t j = 0; j < structures.size(); j++)
+	{
+		Target& structure = structure_state(static_cast<int>(j));
+		if (structure.body >= 0)
+		{
+			physics.removeBody(structure.body);
+			structure.body = -1;
+		}
+	}
+
+	const LevelFormat::Structure* layout = level ? levels.structures(*level) : nullptr;
+	for (int j = 0; j < structure_count; j++)
+	{
+		Target& structure = structure_state(j);
+		if (structure.standing == false)
+		{
+			continue;
+		}
+
+		PhysicsWorld::BodyDef body;
+		body.bounds = structures[j].spriteComponent()->getBoundingBox();
+		body.category = BODY_STRUCTURES;
+		body.mask = BODY_STRUCTURES;
+		if (levels.material(layout[j].material).hit_points > 0)
+		{
+			body.mass = roof_mass;
+			body.awake = false;
+		}
+
+		//the wall top sits under the bottom of a roof sharing the house's corner
+		else
+		{
+			for (int r = 0; r < structure_count; r++)
+			{
+				const rect roof = structures[r].spriteComponent()->getBoundingBox();
+				if (r != j && levels.material(layout[r].material).hit_points > 0 &&
+					roof.x == body.bounds.x && roof.y == body.bounds.y)
 				{
-					high_score = player_score;
+					body.bounds.y = roof.y + roof.height;
 				}
-
-				reset_army_positions();
-				current_lives = max_lives;
-				reset_rock_postions();
-				initalise_buildings();
-				//loadSprites();
-				gameover = true;
 			}
 
-			if (gameover == true)
+			body.bounds.height = wall_top_height;
+			body.mass = 0;
+		}
+
+		structure.body = physics.addBody(body);
+	}
+}
+
+/**
+*   @brief   Moves knocked roofs to their bodies
+*   @details Standing roofs take their colliders with them. A
+destroyed roof stays in the world until it comes to rest or
+falls off screen, then leaves it.
+*   @return  void
+*/
+void AngryBirdsGame::update_structure_bodies()
+{
+	for (int j = 0; j < structure_count; j++)
+	{
+		Target& structure = structure_state(j);
+		if (structure.body < 0 || physics.isStatic(structure.body))
+		{
+			continue;
+		}
+
+		const rect body = physics.bounds(structure.body);
+		ASGE::Sprite* sprite = structures[j].spriteComponent()->getSprite();
+		if (body.x != sprite->xPos() || body.y != sprite->yPos())
+		{
+			sprite->xPos(body.x);
+			sprite->yPos(body.y);
+			if (colliders.contains(j))
 			{
-				reset_king_positions();
-				freeze_cursor = false;
-				reset_army_positions();
-				current_lives = max_lives;
-				reset_rock_postions();
-				initalise_buildings();
-				//loadSprites();
+				colliders.remove(j);
+				colliders.insert(j, structures[j].spriteComponent()->getBoundingBox());
 			}
 		}
+
+		if (structure.standing == false && (!physics.isAwake(structure.body) || body.y > game_height))
+		{
+			physics.removeBody(structure.body);
+			structure.body = -1;
+		}
+	}
+}
+
+/**
+*   @brief   Readies the next rock once the last one is spent
+*   @return  void
+*/
+void AngryBirdsGame::update_spawning()
+{
+	Profiler::Scope scope(profiler, profile_spawning);
+
+	//spawner
+	if (spawner == true)
+	{
+		freeze_cursor = false;
+		spawn = +1;
+		rock_state(spawn).visible = true;
+		reset_rock_postions();
+		spawner = false;
 	}
+}
 
+/**
+*   @brief   Moves every sprite to its entity's transform
+*   @details Runs at the end of each tick and after the rocks are
+reset, so the interpolator and renderer only ever see the
+positions of finished ticks.
+*   @return  void
+*/
+void AngryBirdsGame::sync_sprites()
+{
+	for (size_t k = 0; k < renderables.size(); k++)
+	{
+		const Transform* transform = transforms.get(renderables.entity(k));
+		if (transform)
+		{
+			renderables[k].sprite->xPos(transform->x);
+			renderables[k].sprite->yPos(transform->y);
+		}
+	}
 }
 
 
 /**
 *   @brief   Renders the scene
-*   @details Renders all the game objects to the current frame.
+*   @details Submits all the game objects to the render queue, which
+draws them sorted by layer and texture at the end of the frame.
 Once the current frame is has finished the buffers are
 swapped accordingly and the image shown.
 *   @return  void
 */
 void AngryBirdsGame::render(const ASGE::GameTime &)
 {
+	const auto submit_start = Profiler::Clock::now();
 	renderer->setFont(0);
+	interpolator.apply(static_cast<float>(timestep.alpha()));
 
 	//background
 	background_sprite = background.spriteComponent()->getSprite();
-	renderer->renderSprite(*background_sprite);
-
-	if (in_menu)
-	{
-		std::string high_scores = "YOUR CURRENT HIGHSCORE: " + std::to_string(high_score);
-		renderer->renderText(high_scores.c_str(), 100, 750, 1.0, ASGE::COLOURS::GHOSTWHITE);
-
-		//reset score
-		player_score = 0;
+	render_queue.submit(*background_sprite, RenderLayer::BACKGROUND);
 
-		//reset rocks
-		for (int i = 0; i < max_rocks; i++)
-		{
-			rocks[i].fired = false;
-		}
+	states.render();
 
-		//get menu sprites
-		menu_title_sprite = menu_title.spriteComponent()->getSprite();
-		menu_start_sprite = menu_start.spriteComponent()->getSprite();
-		menu_exit_sprite = menu_exit.spriteComponent()->getSprite();
+	//cursor
+	cursor_sprite = cursor.spriteComponent()->getSprite();
+	render_queue.submit(*cursor_sprite, RenderLayer::CURSOR);
 
-		//set pos
-		menu_title_sprite->xPos(game_width / 2 - 500);
-		menu_title_sprite->yPos(100);
-		menu_start_sprite->xPos(game_width / 2 - 230);
-		menu_start_sprite->yPos(350);
-		menu_exit_sprite->xPos(game_width / 2 - 230);
-		menu_exit_sprite->yPos(500);
+	//overlay
+	overlay_sprite = overlay.spriteComponent()->getSprite();
+	render_queue.submit(*overlay_sprite, RenderLayer::OVERLAY);
 
-		//render sprites
-		renderer->renderSprite(*menu_title_sprite);
-		renderer->renderSprite(*menu_start_sprite);
-		renderer->renderSprite(*menu_exit_sprite);
+	if (show_profile)
+	{
+		render_profile();
 	}
+	profiler.add(profile_submit, submit_start, Profiler::Clock::now());
 
-	else if (!in_menu)
+	//draw everything sorted by layer and texture
 	{
-		//catapult
-		catapult_sprite = catapult.spriteComponent()->getSprite();
-		renderer->renderSprite(*catapult_sprite);
+		Profiler::Scope scope(profiler, profile_flush);
+		render_queue.flush(renderer.get());
+	}
+	interpolator.restore();
 
-		//render building
-		for (int j = 0; j < max_buildings; j++)
-		{
-			//get sprites
-			building1_sprite[j] = building1[j].spriteComponent()->getSprite();
-			building1_roof_sprite[j] = building1_roof[j].spriteComponent()->getSprite();
+	render_end = Profiler::Clock::now();
+	rendered = true;
+}
 
-			//building1
-			building1_sprite[j] = building1[j].spriteComponent()->getSprite();
-			if (building1[j].visibility == true)
-			{
-				renderer->renderSprite(*building1_sprite[j]);
-			}
+void AngryBirdsGame::render_menu()
+{
+	high_score_label.set(high_score);
+	render_queue.submitText(high_score_label, 100, 750, 1.0, ASGE::COLOURS::GHOSTWHITE, RenderLayer::UI);
 
-			//building1 roof
-			building1_roof_sprite[j] = building1_roof[j].spriteComponent()->getSprite();
-			if (building1_roof[j].visibility == true)
-			{
-				renderer->renderSprite(*building1_roof_sprite[j]);
-			}
-		}
+	//render sprites
+	render_queue.submit(*menu_title_sprite, RenderLayer::UI);
+	render_queue.submit(*menu_start_sprite, RenderLayer::BUTTONS);
+	render_queue.submit(*menu_exit_sprite, RenderLayer::BUTTONS);
+}
 
-		//army
-		army_sprite = army.spriteComponent()->getSprite();
-		renderer->renderSprite(*army_sprite);
+/**
+*   @brief   Draws the level, its score and its par
+*   @details Every state but the menu draws the level, the others
+then add their signs over it.
+*   @return  void
+*/
+void AngryBirdsGame::render_level()
+{
+	//catapult
+	catapult_sprite = catapult.spriteComponent()->getSprite();
+	render_queue.submit(*catapult_sprite, RenderLayer::BUILDINGS);
 
-		//king
-		if (king.visibility == true)
+	//render building
+	for (int j = 0; j < structure_count; j++)
+	{
+		//structures stay drawn until they are destroyed, and knocked roofs until they settle
+		const Target& structure = structure_state(j);
+		if (structure.standing == true || structure.body >= 0)
 		{
-			king_sprite = king.spriteComponent()->getSprite();
-			renderer->renderSprite(*king_sprite);
+			render_queue.submit(*structures[j].spriteComponent()->getSprite(), RenderLayer::BUILDINGS);
 		}
+	}
+
+	//army
+	army_sprite = army.spriteComponent()->getSprite();
+	render_queue.submit(*army_sprite, RenderLayer::ARMY);
 
-		//rock array
-		for (int i = 0; i < max_rocks; i++)
+	//king
+	if (king.visibility == true)
+	{
+		king_sprite = king.spriteComponent()->getSprite();
+		render_queue.submit(*king_sprite, RenderLayer::ARMY);
+	}
+
+	//rock array
+	for (int i = 0; i < max_rocks; i++)
+	{
+		if (rock_state(i).visible == true)
 		{
-			if (rocks[i].visibility == true)
+			if (rock_state(i).fired == false)
 			{
-				if (rocks[i].fired == false)
-				{
-					renderer->renderSprite(*rocks_sprite[i]);
-				}
+				render_queue.submit(*renderables.get(rock_entities[i])->sprite, RenderLayer::ROCKS);
 			}
 		}
+	}
+
+	//render score
+	score_label.set(player_score);
+	render_queue.submitText(score_label, 100, 750, 1.0, ASGE::COLOURS::GHOSTWHITE, RenderLayer::UI);
+
+	//render the level's par
+	if (level)
+	{
+		par_label.set(level->par_score);
+		render_queue.submitText(par_label, 300, 750, 1.0, ASGE::COLOURS::GHOSTWHITE, RenderLayer::UI);
+	}
+}
 
-		//victory
-		if (victory_bool == true)
+void AngryBirdsGame::render_intro()
+{
+	render_level();
+
+	//the intro of the level about to start, once it has streamed in
+	ASGE::Sprite* intro_sprite = current_level <= intro_count ? level_intro_sprites[current_level - 1] : nullptr;
+	if (intro_sprite)
+	{
+		render_queue.submit(*intro_sprite, RenderLayer::UI);
+	}
+	render_queue.submit(*level_start_sprite, RenderLayer::BUTTONS);
+
+	//the start button waits for the level's images, or retries them
+	if (level != levels.level(current_level - 1))
+	{
+		if (level_status == AssetStreamer::Status::FAILED)
 		{
-			//get menu sprites
-			victory_sprite = victory.spriteComponent()->getSprite();
-			//set pos
-			victory_sprite->xPos(game_width / 2 - 300);
-			victory_sprite->yPos(100);
-
-			//render sprites
-			renderer->renderSprite(*victory_sprite);
+			load_failed_label.set(static_cast<int>(streamer.progress().failed));
+			render_queue.submitText(load_failed_label, game_width / 2 - 250, 620, 1.0, ASGE::COLOURS::GHOSTWHITE, RenderLayer::BUTTONS);
 		}
-
-		//level 1
-		if (level_1_intro_bool == true)
+		else
 		{
-			//get menu sprites
-			level1_intro_sprite = level1_intro.spriteComponent()->getSprite();
-			level_start_sprite = level_start.spriteComponent()->getSprite();
-			//set pos
-			level1_intro_sprite->xPos(game_width / 2 - 200);
-			level1_intro_sprite->yPos(100);
-			level_start_sprite->xPos(game_width / 2 - 120);
-			level_start_sprite->yPos(480);
-
-			//render sprites
-			renderer->renderSprite(*level1_intro_sprite);
-			renderer->renderSprite(*level_start_sprite);
+			loading_label.set(static_cast<int>(streamer.fraction() * 100));
+			render_queue.submitText(loading_label, game_width / 2 - 80, 620, 1.0, ASGE::COLOURS::GHOSTWHITE, RenderLayer::BUTTONS);
 		}
+	}
+}
+
+void AngryBirdsGame::render_gameover()
+{
+	render_level();
+	render_queue.submit(*gameover_sign_sprite, RenderLayer::UI);
+	render_queue.submit(*okay_sprite, RenderLayer::BUTTONS);
+}
 
-		//level 2
-		if (level_2_intro_bool == true)
+void AngryBirdsGame::render_victory()
+{
+	render_level();
+	render_queue.submit(*victory_sprite, RenderLayer::UI);
+}
+
+/**
+*   @brief   Draws the profiler's breakdown
+*   @details The summary is refreshed twice a second, as sorting
+the samples for the percentiles is not free.
+*   @return  void
+*/
+void AngryBirdsGame::render_profile()
+{
+	if (profile_lines.empty() || --profile_refresh <= 0)
+	{
+		profile_refresh = 30;
+		profile_lines.clear();
+		profile_lines.push_back("SECTION       MIN      AVG      P99 MS");
+
+		char line[80];
+		for (const auto& summary : profiler.summarise())
 		{
-			//get menu sprites
-			level2_intro_sprite = level2_intro.spriteComponent()->getSprite();
-			level_start_sprite = level_start.spriteComponent()->getSprite();
-			//set pos
-			level2_intro_sprite->xPos(game_width / 2 - 200);
-			level2_intro_sprite->yPos(100);
-			level_start_sprite->xPos(game_width / 2 - 120);
-			level_start_sprite->yPos(480);
-
-			//render sprites
-			renderer->renderSprite(*level2_intro_sprite);
-			renderer->renderSprite(*level_start_sprite);
+			std::snprintf(line, sizeof(line), "%-10s %7.3f  %7.3f  %7.3f",
+				summary.name->c_str(), summary.min_ms, summary.avg_ms, summary.p99_ms);
+			profile_lines.push_back(line);
 		}
 
-		//level 3
-		if (level_3_intro_bool == true)
+		//how long init took, and the startup images if they were not in the atlas
+		std::snprintf(line, sizeof(line), "STARTUP %.1f MS", startup_ms);
+		if (startup_textures.files)
 		{
-			//get menu sprites
-			level3_intro_sprite = level3_intro.spriteComponent()->getSprite();
-			level_start_sprite = level_start.spriteComponent()->getSprite();
-			//set pos
-			level3_intro_sprite->xPos(game_width / 2 - 200);
-			level3_intro_sprite->yPos(100);
-			level_start_sprite->xPos(game_width / 2 - 120);
-			level_start_sprite->yPos(480);
-
-			//render sprites
-			renderer->renderSprite(*level3_intro_sprite);
-			renderer->renderSprite(*level_start_sprite);
+			std::snprintf(line, sizeof(line), "STARTUP %.1f MS, %zu IMAGES IN %.1f + %.1f MS ON %u THREADS",
+				startup_ms, startup_textures.files, startup_textures.decode_ms,
+				startup_textures.upload_ms, startup_textures.threads);
 		}
+		profile_lines.push_back(line);
 
-		if (gameover == true && victory_bool == false)
+		//the last change of state and what its hooks cost
+		const auto& transition = states.lastTransition();
+		std::snprintf(line, sizeof(line), "STATE %s IN %.3f MS", states.name(states.current()), transition.hooks_ms);
+		if (transition.from != states.NONE)
 		{
-			//get gameover sprites
-			gameover_sign_sprite = gameover_sign.spriteComponent()->getSprite();
-			okay_sprite = okay.spriteComponent()->getSprite();
-
-			//set pos
-			gameover_sign_sprite->xPos(game_width / 2 - 300);
-			gameover_sign_sprite->yPos(300);
-			okay_sprite->xPos(game_width / 2 - 265);
-			okay_sprite->yPos(470);
-
-			//render sprites
-			renderer->renderSprite(*gameover_sign_sprite);
-			renderer->renderSprite(*okay_sprite);
+			std::snprintf(line, sizeof(line), "STATE %s IN %.3f MS, FROM %s AFTER %.0f MS",
+				states.name(states.current()), transition.hooks_ms,
+				states.name(transition.from), transition.stayed_ms);
+		}
+		profile_lines.push_back(line);
+
+		//a reloaded hit is the engine decoding a file the cache already holds
+		const TextureCache::Stats& textures = TextureCache::global().stats();
+		std::snprintf(line, sizeof(line), "TEXTURES %u LOADED, %u HITS, %u RELOADED",
+			textures.misses, textures.hits, textures.reloaded);
+		profile_lines.push_back(line);
+
+		const InputBus::Stats input = input_bus.stats();
+		std::snprintf(line, sizeof(line), "INPUT %u EVENTS, %u MOVES MERGED, %u DROPPED",
+			input.posted, input.merged, input.dropped);
+		profile_lines.push_back(line);
+
+		//pools should never need the heap once the game is running
+		profile_lines.push_back("POOL       USED  PEAK   CAP  HEAP");
+		for (const PoolStats* pool : { &GameObject::componentPool().stats(), &SpritePool::global().stats() })
+		{
+			std::snprintf(line, sizeof(line), "%-10s %4zu  %4zu  %4zu  %4zu",
+				pool->name, pool->in_use, pool->high_water, pool->capacity, pool->heap_fallbacks);
+			profile_lines.push_back(line);
 		}
-
-		//render score
-		std::string score = "SCORE: " + std::to_string(player_score);
-		renderer->renderText(score.c_str(), 100, 750, 1.0, ASGE::COLOURS::GHOSTWHITE);
-
 	}
-	//cursor
-	cursor_sprite = cursor.spriteComponent()->getSprite();
-	renderer->renderSprite(*cursor_sprite);
 
-	//overlay
-	overlay_sprite = overlay.spriteComponent()->getSprite();
-	renderer->renderSprite(*overlay_sprite);
+	for (size_t i = 0; i < profile_lines.size(); i++)
+	{
+		render_queue.submitText(profile_lines[i], 10, 60 + static_cast<int>(i) * 22,
+			1.0, ASGE::COLOURS::YELLOWGREEN, RenderLayer::OVERLAY);
+	}
 }
\ No newline at end of file
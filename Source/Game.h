@@ -1,9 +1,26 @@
 #pragma once
 #include <string>
+#include <vector>
 #include <Engine/OGLGame.h>
 
+#include "AssetStreamer.h"
+#include "Components.h"
+#include "EntityStore.h"
+#include "FixedTimestep.h"
 #include "GameObject.h"
+#include "InputBus.h"
+#include "LevelPack.h"
+#include "PhysicsWorld.h"
+#include "Profiler.h"
 #include "Rect.h"
+#include "RectBatch.h"
+#include "RenderQueue.h"
+#include "SpatialGrid.h"
+#include "SpriteInterpolator.h"
+#include "StateMachine.h"
+#include "TextLabel.h"
+#include "TextureAtlas.h"
+#include "TextureBatch.h"
 
 
 /**
@@ -20,15 +37,46 @@ class AngryBirdsGame :
 
 	private:
 		//OTHER
-		void keyHandler(const ASGE::SharedEventData data);
-		void clickHandler(const ASGE::SharedEventData data);
-		void moveHandler(const ASGE::SharedEventData data);
+		void keyHandler(const InputEvent& key);
+		void moveHandler(const InputEvent& move);
 		void setupResolution();
 		virtual void update(const ASGE::GameTime &) override;
 		virtual void render(const ASGE::GameTime &) override;
+		void render_profile();
+		void tick(double dt_sec);
+
+		//SYSTEMS run once per tick
+		void update_selection(double cursor_x_pos, double cursor_y_pos);
+		void update_army(double dt_sec);
+		void update_rock_flight(double dt_sec, double cursor_y_pos);
+		void update_collisions();
+		void rebuild_colliders();
+		void rebuild_structure_bodies();
+		void update_structure_bodies();
+		void update_spawning();
+		void sync_sprites();
+
+		//STATES hooks, run by the state machine
+		void enter_menu();
+		void update_menu(double dt_sec);
+		void render_menu();
+		void enter_intro();
+		void update_intro(double dt_sec);
+		void render_intro();
+		void enter_playing();
+		void update_playing(double dt_sec);
+		void render_level();
+		void enter_gameover();
+		void render_gameover();
+		void render_victory();
 
 		//USEFUL FUNCTIONS
 		void reset_values();
+		bool load_levels();
+		bool select_level();
+		AssetStreamer::Status stream_level(int level_number);
+		void load_intro(int level_number);
+		bool load_structures();
 		bool initalise_buildings();
 		void reset_rock_postions();
 		void reset_building_postiions();
@@ -36,17 +84,18 @@ class AngryBirdsGame :
 		void reset_game_states();
 		void initalise_rocks();
 		void reset_king_positions();
+		void launch_rock(Entity rock, double dt_sec, double cursor_y_pos);
+		void create_entities();
+		Projectile& rock_state(int i);
+		Transform& rock_transform(int i);
+		Target& structure_state(int i);
 		bool loadSprites();
-		bool victory_bool = false;
 
 		//INTS
 		int key_callback_id = -1;	     
-		int mouse_callback_id = -1;   
 		int mouse_move_callback_id = -1; 
 		int max_rocks = 8;
-		int max_buildings = 4;
 		int spawn = 1;
-		int house_width = 200;
 		int max_lives = 8;
 		int current_lives = 8;
 		int number_selected = 0;
@@ -54,6 +103,9 @@ class AngryBirdsGame :
 		int player_score = 0;
 		int high_score = 0;
 		int current_level = 1;
+		//structure sprite states
+		static const int STRUCTURE_INTACT = 0;
+		static const int STRUCTURE_DAMAGED = 1;
 		//backgrounds
 		float foreground_x_pos;
 		float midground_x_pos;
@@ -67,10 +119,6 @@ class AngryBirdsGame :
 		float catapult_y_pos;
 		float range_x_pos;
 		float range_y_pos;
-		float building1_roof_x_pos;
-		float building1_roof_y_pos;
-		float building1_x_pos;
-		float building1_y_pos;
 		float rock_x_pos;
 		float rock_y_pos;
 		float army_x_pos;
@@ -78,7 +126,7 @@ class AngryBirdsGame :
 		float king_x_pos;
 		float king_y_pos;
 		//OTHER
-		float min_speed = 2;
+		float min_speed = 16;
 		float average_speed = 300;
 		float max_speed = 600;
 		float distance = 0;
@@ -90,17 +138,108 @@ class AngryBirdsGame :
 		bool spawner = false;
 		bool calculate_distance;
 		bool freeze_cursor = false;
-		//BOOLS GAME STATES
-		bool in_menu = true;
-		bool begin = false;
-		bool level_1 = true;
-		bool level_1_intro_bool = true;
-		bool level_2 = false;
-		bool level_2_intro_bool = false;
-		bool level_3 = false;
-		bool level_3_intro_bool = false;
-		bool gameover = false;
-		bool level_reload = false;
+
+		//STATES setup runs on the transition into a state, not every frame
+		static const int STATE_MENU = 0;
+		static const int STATE_INTRO = 1;
+		static const int STATE_PLAYING = 2;
+		static const int STATE_GAMEOVER = 3;
+		static const int STATE_VICTORY = 4;
+		StateMachine<AngryBirdsGame> states{ *this };
+		double cursor_x = 0;
+		double cursor_y = 0;
+
+		//SIMULATION runs at tick_rate, at most max_substeps ticks a frame
+		double tick_rate = 120;
+		int max_substeps = 8;
+		FixedTimestep timestep;
+		SpriteInterpolator interpolator;
+
+		//COLLISION roofs and the king are inserted once per level, rocks query
+		SpatialGrid colliders;
+		std::vector<int> collider_hits;
+		bool colliders_dirty = true;
+
+		//PHYSICS fired rocks are bodies until they are spent, roofs rest on their walls
+		PhysicsWorld physics;
+		static const uint16_t BODY_ROCKS = 1;
+		static const uint16_t BODY_STRUCTURES = 2;
+		float rock_mass = 5.0f;
+		float roof_mass = 10.0f;
+		float wall_top_height = 16.0f;
+
+		//ENTITIES rocks and roofs keep their state in dense component arrays
+		EntityStore entities;
+		ComponentArray<Transform> transforms;
+		ComponentArray<Projectile> projectiles;
+		ComponentArray<Target> targets;
+		ComponentArray<Renderable> renderables;
+		Entity rock_entities[8];
+		std::vector<Entity> structure_entities;
+
+		//LEVELS are mapped from Resources/levels, switching level swaps the pointer
+		LevelPack levels;
+		const LevelFormat::Level* level = nullptr;
+		int structure_count = 0;
+		std::vector<std::string> material_textures;
+		std::vector<std::string> material_damaged_textures;
+
+		//STREAMING loads the next level's images while this one is played
+		AssetStreamer streamer;
+		AssetStreamer::Status level_status = AssetStreamer::Status::READY;
+		static const int intro_count = 3;
+		const std::string intro_textures[intro_count] = {
+			"Resources\\images\\level1_intro.png",
+			"Resources\\images\\level2_intro.png",
+			"Resources\\images\\level3_intro.png" };
+		static const unsigned int uploads_per_frame = 1;
+
+		//CURSOR tests, one batch per tick for the buttons and the rocks
+		static const int BUTTON_START = 0;
+		static const int BUTTON_EXIT = 1;
+		static const int BUTTON_LEVEL = 2;
+		RectBatch button_boxes;
+		std::vector<uint64_t> buttons_under_cursor;
+		RectBatch rock_boxes;
+		std::vector<uint64_t> rocks_under_cursor;
+
+		//INPUT events are queued here by the engine's input thread
+		InputBus input_bus;
+
+		//PROFILING, P toggles the overlay and O dumps the last frames
+		Profiler profiler;
+		bool show_profile = false;
+		bool rendered = false;
+		Profiler::Clock::time_point render_end;
+		int profile_input = -1;
+		int profile_tick = -1;
+		int profile_selection = -1;
+		int profile_army = -1;
+		int profile_flight = -1;
+		int profile_collision = -1;
+		int profile_spawning = -1;
+		int profile_states = -1;
+		int profile_submit = -1;
+		int profile_flush = -1;
+		int profile_present = -1;
+		int profile_refresh = 0;
+		std::vector<std::string> profile_lines;
+		std::string profile_dump;
+		TextureBatch::Timing startup_textures;
+		double startup_ms = 0;
+
+		//RENDERING
+		RenderQueue render_queue;
+
+		//HUD text is only formatted again when the number it shows changes
+		TextLabel score_label{ "SCORE: " };
+		TextLabel par_label{ "PAR: " };
+		TextLabel high_score_label{ "YOUR CURRENT HIGHSCORE: " };
+		TextLabel loading_label{ "LOADING ", "%" };
+		TextLabel load_failed_label{ "", " IMAGES FAILED, CLICK TO RETRY" };
+
+		//ATLAS baked from Resources/images, if present
+		TextureAtlas images_atlas;
 
 		//GAMEOBJECTS
 		GameObject cursor;
@@ -110,10 +249,9 @@ class AngryBirdsGame :
 		GameObject range;
 		GameObject army;
 		GameObject king;
-		//GAMEOBJECTS ARRAY
+		//GAMEOBJECTS ARRAY, the rocks only own their sprites
 		GameObject rocks[8] = {};
-		GameObject building1[4] = {};
-		GameObject building1_roof[4] = {};
+		std::vector<GameObject> structures;
 		//GAMEOBJECTS MENU
 		GameObject menu_title;
 		GameObject menu_start;
@@ -124,9 +262,7 @@ class AngryBirdsGame :
 		//GAMEOBJECTS LEVEL START
 		GameObject level_start;
 		//GAMEOBJECTS LEVEL INTROS
-		GameObject level1_intro;
-		GameObject level2_intro;
-		GameObject level3_intro;
+		GameObject level_intros[intro_count];
 		//VICTORY
 		GameObject victory;
 
@@ -138,10 +274,6 @@ class AngryBirdsGame :
 		ASGE::Sprite* range_sprite;
 		ASGE::Sprite* army_sprite;
 		ASGE::Sprite* king_sprite;
-		//SPRITES ARRAY
-		ASGE::Sprite* building1_sprite[4] = {};
-		ASGE::Sprite* building1_roof_sprite[4] = {};
-		ASGE::Sprite* rocks_sprite[8] = {};
 		//SPRITES MENU
 		ASGE::Sprite* menu_title_sprite;
 		ASGE::Sprite* menu_start_sprite;
@@ -151,10 +283,8 @@ class AngryBirdsGame :
 		ASGE::Sprite* okay_sprite;
 		//SPRITES START
 		ASGE::Sprite* level_start_sprite;
-		//SPRITES INTRO
-		ASGE::Sprite* level1_intro_sprite;
-		ASGE::Sprite* level2_intro_sprite;
-		ASGE::Sprite* level3_intro_sprite;
+		//SPRITES INTRO, null until the level's intro is resident
+		ASGE::Sprite* level_intro_sprites[intro_count] = {};
 		//SPRITES
 		ASGE::Sprite* victory_sprite;
 
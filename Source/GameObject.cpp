@@ -1,17 +1,55 @@
-#include <Engine\Renderer.h>
+#include <Engine/Renderer.h>
 #include "GameObject.h"
 
+/**
+*   @brief   Returns the pool every sprite component is made in.
+*   @details Sized for every object the game creates, with room to
+             spare; the stats show if it ever has to use the heap.
+*   @return  The shared pool.
+*/
+ObjectPool<SpriteComponent>& GameObject::componentPool()
+{
+	static ObjectPool<SpriteComponent> pool(64, "components");
+	return pool;
+}
+
 GameObject::~GameObject()
 {
 	freeSpriteComponent();
 }
 
+GameObject::GameObject(GameObject&& rhs) noexcept
+	: col_num(rhs.col_num), visibility(rhs.visibility),
+	selected(rhs.selected), fired(rhs.fired),
+	sprite_component(rhs.sprite_component)
+{
+	rhs.sprite_component = nullptr;
+}
+
+GameObject& GameObject::operator=(GameObject&& rhs) noexcept
+{
+	if (this != &rhs)
+	{
+		freeSpriteComponent();
+		col_num = rhs.col_num;
+		visibility = rhs.visibility;
+		selected = rhs.selected;
+		fired = rhs.fired;
+		sprite_component = rhs.sprite_component;
+		rhs.sprite_component = nullptr;
+	}
+
+	return *this;
+}
+
 bool GameObject::addSpriteComponent(
 	ASGE::Renderer* renderer, const std::string& texture_file_name)
 {
-	freeSpriteComponent();
+	if (!sprite_component)
+	{
+		sprite_component = componentPool().create();
+	}
 
-	sprite_component = new SpriteComponent();
 	if (sprite_component->loadSprite(renderer, texture_file_name))
 	{
 		return true;
@@ -21,10 +59,38 @@ bool GameObject::addSpriteComponent(
 	return false;
 }
 
+bool GameObject::addSpriteComponent(
+	ASGE::Renderer* renderer, const TextureAtlas& atlas, const std::string& name)
+{
+	if (!sprite_component)
+	{
+		sprite_component = componentPool().create();
+	}
+
+	if (sprite_component->loadSprite(renderer, atlas, name))
+	{
+		return true;
+	}
+
+	freeSpriteComponent();
+	return false;
+}
+
+bool GameObject::addSpriteState(
+	ASGE::Renderer* renderer, int state, const std::string& texture_file_name)
+{
+	if (!sprite_component)
+	{
+		return false;
+	}
+
+	return sprite_component->loadState(renderer, state, texture_file_name);
+}
+
 
 void  GameObject::freeSpriteComponent()
 {
-	delete sprite_component;
+	componentPool().destroy(sprite_component);
 	sprite_component = nullptr;
 }
 
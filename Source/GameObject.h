@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include "ObjectPool.h"
 #include "SpriteComponent.h"
 #include "Vector2.h"
 
@@ -23,16 +24,51 @@ public:
 	*/
 	~GameObject();
 
+	/**
+	*  Move constructor. Takes over the other object's component.
+	*/
+	GameObject(GameObject&& rhs) noexcept;
+
+	/**
+	*  Move assignment. Frees this object's component and takes over
+	*  the other's.
+	*/
+	GameObject& operator=(GameObject&& rhs) noexcept;
+
+	GameObject(const GameObject&) = delete;
+	GameObject& operator=(const GameObject&) = delete;
+
 	/**
 	*  Allocates and attaches a sprite component to the object. 
 	*  Part of this process will attempt to load a texture file.
-	*  If this fails this function will return false and the memory
-	*  allocated, freed. 
+	*  An existing component is reused, so reloading the same texture
+	*  is cheap. If this fails this function will return false and the
+	*  memory allocated, freed. 
 	*  @param [in] renderer The renderer used to perform the allocations
 	*  @param [in] texture_file_name The file path to the the texture to load
 	*  @return true if the component is successfully added
 	*/
 	bool  addSpriteComponent(ASGE::Renderer* renderer, const std::string& texture_file_name);
+
+	/**
+	*  Allocates and attaches a sprite component drawn from an atlas.
+	*  @param [in] renderer The renderer used to perform the allocations
+	*  @param [in] atlas The atlas containing the sub texture
+	*  @param [in] name The name of the sub texture to draw
+	*  @return true if the component is successfully added
+	*/
+	bool  addSpriteComponent(ASGE::Renderer* renderer, const TextureAtlas& atlas, const std::string& name);
+
+	/**
+	*  Loads an additional state into the object's sprite component.
+	*  The sprite component must already have been added. States are
+	*  swapped with SpriteComponent::setState without any loading.
+	*  @param [in] renderer The renderer used to perform the allocations
+	*  @param [in] state The state index to load the texture into
+	*  @param [in] texture_file_name The file path to the the texture to load
+	*  @return true if the state is successfully loaded
+	*/
+	bool  addSpriteState(ASGE::Renderer* renderer, int state, const std::string& texture_file_name);
 	
 	//number of times object has been collided with
 	int col_num = 0;
@@ -51,6 +87,13 @@ public:
 	*/
 	 SpriteComponent* spriteComponent();
 
+	/**
+	*  Returns the pool sprite components are allocated from.
+	*  Use its stats to check the pool is large enough.
+	*  @return the pool shared by every game object
+	*/
+	static ObjectPool<SpriteComponent>& componentPool();
+
 
 private:
 
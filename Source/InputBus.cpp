@@ -0,0 +1,264 @@
+#include <thread>
+#include <Engine/Input.h>
+#include <Engine/Keys.h>
+#include "InputBus.h"
+
+namespace
+{
+	//a handle holds the handler's type above its slot in the type's table
+	const int TYPE_SHIFT = 16;
+}
+
+InputBus::~InputBus()
+{
+	disconnect();
+}
+
+int InputBus::subscribe(ASGE::EventType type, void* target, Thunk thunk)
+{
+	std::vector<Delegate>& table = handlers[type];
+	table.push_back(Delegate{ target, thunk });
+	return (static_cast<int>(type) << TYPE_SHIFT) | static_cast<int>(table.size() - 1);
+}
+
+/**
+*   @brief   Removes a handler.
+*   @details The slot is emptied rather than erased so the other
+             handles stay valid.
+*   @return  void
+*/
+void InputBus::unsubscribe(int id) noexcept
+{
+	const int type = id >> TYPE_SHIFT;
+	const size_t slot = static_cast<size_t>(id & ((1 << TYPE_SHIFT) - 1));
+	if (id >= 0 && type < EVENT_TYPES && slot < handlers[type].size())
+	{
+		handlers[type][slot] = Delegate();
+	}
+}
+
+void InputBus::connect(ASGE::Input* engine_input)
+{
+	disconnect();
+	input = engine_input;
+	if (input)
+	{
+		input->getCursorPos(current.cursor_x, current.cursor_y);
+		callbacks[0] = input->addCallbackFnc(ASGE::E_KEY, &InputBus::onKey, this);
+		callbacks[1] = input->addCallbackFnc(ASGE::E_MOUSE_CLICK, &InputBus::onClick, this);
+		callbacks[2] = input->addCallbackFnc(ASGE::E_MOUSE_MOVE, &InputBus::onMove, this);
+	}
+}
+
+void InputBus::disconnect()
+{
+	if (input)
+	{
+		for (int& callback : callbacks)
+		{
+			input->unregisterCallback(callback);
+			callback = -1;
+		}
+	}
+
+	input = nullptr;
+}
+
+/**
+*   @brief   Copies an event into the queue.
+*   @details The queue takes one producer, but the engine may run its
+             callbacks on more than one thread, so producers take
+             turns. Only producers ever wait here; the game's thread
+             never does.
+*   @return  False if the event was dropped.
+*/
+bool InputBus::post(const InputEvent& event) noexcept
+{
+	while (producing.test_and_set(std::memory_order_acquire))
+	{
+		std::this_thread::yield();
+	}
+
+	const bool queued = queue.push(event);
+	producing.clear(std::memory_order_release);
+
+	posted.fetch_add(1, std::memory_order_relaxed);
+	if (!queued)
+	{
+		dropped.fetch_add(1, std::memory_order_relaxed);
+	}
+	return queued;
+}
+
+/**
+*   @brief   Hands each queued event to its type's handlers.
+*   @details A move followed by another move is only folded into the
+             snapshot, as handlers only need to know where the cursor
+             ended up. At most a queue's worth of events is drained,
+             so a producer that never stops cannot hold the frame.
+*   @return  void
+*/
+void InputBus::dispatch()
+{
+	InputEvent event;
+	InputEvent move;
+	bool moving = false;
+	for (size_t drained = 0; drained < CAPACITY && queue.pop(event); drained++)
+	{
+		if (event.type == ASGE::E_MOUSE_MOVE)
+		{
+			if (moving)
+			{
+				current.apply(move);
+				merged++;
+			}
+
+			move = event;
+			moving = true;
+			continue;
+		}
+
+		if (moving)
+		{
+			deliver(move);
+			moving = false;
+		}
+		deliver(event);
+	}
+
+	if (moving)
+	{
+		deliver(move);
+	}
+}
+
+void InputBus::deliver(const InputEvent& event)
+{
+	current.apply(event);
+	dispatched++;
+
+	for (const Delegate& handler : handlers[event.type])
+	{
+		if (handler.thunk)
+		{
+			handler.thunk(handler.target, event);
+		}
+	}
+}
+
+const InputSnapshot& InputBus::snapshot() const noexcept
+{
+	return current;
+}
+
+void InputBus::endTick() noexcept
+{
+	current.endTick();
+}
+
+InputBus::Stats InputBus::stats() const noexcept
+{
+	Stats stats;
+	stats.posted = posted.load(std::memory_order_relaxed);
+	stats.merged = merged;
+	stats.dropped = dropped.load(std::memory_order_relaxed);
+	stats.dispatched = dispatched;
+	return stats;
+}
+
+void InputBus::onKey(const ASGE::SharedEventData data)
+{
+	auto key = static_cast<const ASGE::KeyEvent*>(data.get());
+	InputEvent event;
+	event.type = ASGE::E_KEY;
+	event.key = key->key;
+	event.action = key->action;
+	event.mods = key->mods;
+	post(event);
+}
+
+void InputBus::onClick(const ASGE::SharedEventData data)
+{
+	auto click = static_cast<const ASGE::ClickEvent*>(data.get());
+	InputEvent event;
+	event.type = ASGE::E_MOUSE_CLICK;
+	event.button = click->button;
+	event.action = click->action;
+	event.mods = click->mods;
+	post(event);
+}
+
+void InputBus::onMove(const ASGE::SharedEventData data)
+{
+	auto move = static_cast<const ASGE::MoveEvent*>(data.get());
+	InputEvent event;
+	event.type = ASGE::E_MOUSE_MOVE;
+	event.x = move->xpos;
+	event.y = move->ypos;
+	post(event);
+}
+
+bool InputSnapshot::down(int button) const noexcept
+{
+	return button >= 0 && button < BUTTONS && (held[button] || pressed[button]);
+}
+
+bool InputSnapshot::keyPressed(int key) const noexcept
+{
+	for (int i = 0; i < key_count; i++)
+	{
+		if (keys[i] == key)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+*   @brief   Folds an event into the snapshot.
+*   @details Presses past MAX_KEYS in one tick are not recorded, but
+             still reach the bus's handlers.
+*   @return  void
+*/
+void InputSnapshot::apply(const InputEvent& event) noexcept
+{
+	switch (event.type)
+	{
+	case ASGE::E_MOUSE_MOVE:
+		cursor_x = event.x;
+		cursor_y = event.y;
+		moved = true;
+		break;
+
+	case ASGE::E_MOUSE_CLICK:
+		if (event.button >= 0 && event.button < BUTTONS)
+		{
+			const bool is_down = event.action == ASGE::KEYS::KEY_PRESSED;
+			held[event.button] = is_down;
+			(is_down ? pressed : released)[event.button] = true;
+		}
+		break;
+
+	case ASGE::E_KEY:
+		if (event.action == ASGE::KEYS::KEY_PRESSED && key_count < MAX_KEYS)
+		{
+			keys[key_count++] = event.key;
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+void InputSnapshot::endTick() noexcept
+{
+	moved = false;
+	for (int i = 0; i < BUTTONS; i++)
+	{
+		pressed[i] = false;
+		released[i] = false;
+	}
+	key_count = 0;
+}
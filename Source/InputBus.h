@@ -0,0 +1,195 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <vector>
+#include <Engine/InputEvents.h>
+#include "SpscQueue.h"
+
+namespace ASGE {
+	class Input;
+}
+
+/**
+*  An input event held by value.
+*  One flat struct covers keys, clicks and cursor moves, so events are
+*  kept in a fixed array rather than each being allocated on its own.
+*/
+struct InputEvent
+{
+	ASGE::EventType type = ASGE::E_KEY;
+	int key = -1;        /**< E_KEY: the key. */
+	int button = -1;     /**< E_MOUSE_CLICK: the mouse button. */
+	int action = -1;     /**< E_KEY and E_MOUSE_CLICK: pressed or released. */
+	int mods = 0;        /**< E_KEY and E_MOUSE_CLICK: any modifiers. */
+	double x = 0;        /**< E_MOUSE_MOVE: the cursor's position. */
+	double y = 0;
+};
+
+/**
+*  The input the simulation sees for one tick.
+*  Buttons are held until their release is seen, and the edges say
+*  whether a button went down or up, or a key was pressed, since the
+*  last tick, so a click that starts and ends between two ticks is
+*  still seen as a press.
+*/
+struct InputSnapshot
+{
+	static const int BUTTONS = 3;
+	static const int MAX_KEYS = 16;
+
+	double cursor_x = 0;              /**< Where the cursor was last moved to. */
+	double cursor_y = 0;
+	bool moved = false;               /**< True if the cursor moved since the last tick. */
+	bool held[BUTTONS] = {};          /**< The buttons down at the end of the tick's input. */
+	bool pressed[BUTTONS] = {};       /**< The buttons that went down since the last tick. */
+	bool released[BUTTONS] = {};      /**< The buttons that went up since the last tick. */
+	int keys[MAX_KEYS] = {};          /**< The keys pressed since the last tick, in order. */
+	int key_count = 0;
+
+	/**
+	*  Returns true if a button is held, or was clicked since the last tick.
+	*/
+	bool down(int button) const noexcept;
+
+	/**
+	*  Returns true if a key was pressed since the last tick.
+	*/
+	bool keyPressed(int key) const noexcept;
+
+	/**
+	*  Folds an event into the snapshot.
+	*/
+	void apply(const InputEvent& event) noexcept;
+
+	/**
+	*  Clears the edges once a tick has seen them.
+	*/
+	void endTick() noexcept;
+};
+
+/**
+*  Queues input events and hands them to handlers by type.
+*  The engine's callbacks copy events into a lock-free single producer,
+*  single consumer queue, so they can run on the engine's input thread
+*  without ever waiting on the simulation, and the game drains the queue
+*  when dispatch is called, so handlers run on the game's thread at a
+*  known point in the frame. Each event type has its own table of
+*  handlers, and a handler is a member function bound at compile time to
+*  its object, so delivering an event is one indirect call per handler
+*  with nothing allocated. Consecutive cursor moves are delivered as one,
+*  and every event is also folded into an InputSnapshot the ticks read.
+*  When the queue is full further events are dropped and counted.
+*/
+class InputBus
+{
+public:
+	static const size_t CAPACITY = 1024;
+	static const int EVENT_TYPES = ASGE::E_GAMEPAD_STATUS + 1;
+
+	/**
+	*  Counters since the bus was made.
+	*/
+	struct Stats
+	{
+		unsigned int posted = 0;      /**< Events posted. */
+		unsigned int merged = 0;      /**< Moves delivered as part of the move after them. */
+		unsigned int dropped = 0;     /**< Events lost to a full queue. */
+		unsigned int dispatched = 0;  /**< Events handed to handlers. */
+	};
+
+	InputBus() = default;
+
+	/**
+	*  Destructor. Disconnects from the engine's input.
+	*/
+	~InputBus();
+
+	InputBus(const InputBus&) = delete;
+	InputBus& operator=(const InputBus&) = delete;
+
+	/**
+	*  Calls a member function for every event of a type.
+	*  Usage: bus.subscribe<Game, &Game::keyHandler>(ASGE::E_KEY, this);
+	*  @param [in] type The type of event to handle
+	*  @param [in] target The object to call the member function on
+	*  @return The subscription's handle
+	*/
+	template <typename T, void (T::*Method)(const InputEvent&)>
+	int subscribe(ASGE::EventType type, T* target)
+	{
+		return subscribe(type, target, &call<T, Method>);
+	}
+
+	/**
+	*  Removes a handler.
+	*  @param [in] id The handle returned by subscribe
+	*/
+	void unsubscribe(int id) noexcept;
+
+	/**
+	*  Posts the engine's key, click and move events to this bus.
+	*  Any input already connected is disconnected first.
+	*/
+	void connect(ASGE::Input* input);
+
+	/**
+	*  Stops posting the engine's events.
+	*/
+	void disconnect();
+
+	/**
+	*  Queues an event. Safe to call from any thread.
+	*  @return false if the queue was full and the event was dropped
+	*/
+	bool post(const InputEvent& event) noexcept;
+
+	/**
+	*  Delivers the queued events in the order they were posted and
+	*  folds them into the snapshot. Only call from the game's thread.
+	*/
+	void dispatch();
+
+	/**
+	*  Returns the input seen by dispatch since the last endTick.
+	*/
+	const InputSnapshot& snapshot() const noexcept;
+
+	/**
+	*  Clears the snapshot's edges once a tick has read them.
+	*/
+	void endTick() noexcept;
+
+	Stats stats() const noexcept;
+
+private:
+	using Thunk = void (*)(void* target, const InputEvent& event);
+
+	struct Delegate
+	{
+		void* target = nullptr;
+		Thunk thunk = nullptr;
+	};
+
+	template <typename T, void (T::*Method)(const InputEvent&)>
+	static void call(void* target, const InputEvent& event)
+	{
+		(static_cast<T*>(target)->*Method)(event);
+	}
+
+	int subscribe(ASGE::EventType type, void* target, Thunk thunk);
+	void deliver(const InputEvent& event);
+	void onKey(const ASGE::SharedEventData data);
+	void onClick(const ASGE::SharedEventData data);
+	void onMove(const ASGE::SharedEventData data);
+
+	SpscQueue<InputEvent, CAPACITY> queue;
+	std::atomic_flag producing = ATOMIC_FLAG_INIT;
+	std::atomic<unsigned int> posted{ 0 };
+	std::atomic<unsigned int> dropped{ 0 };
+	unsigned int merged = 0;
+	unsigned int dispatched = 0;
+	InputSnapshot current;
+	std::vector<Delegate> handlers[EVENT_TYPES];
+	ASGE::Input* input = nullptr;
+	int callbacks[3] = { -1, -1, -1 };
+};
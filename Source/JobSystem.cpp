@@ -0,0 +1,101 @@
+#include "JobSystem.h"
+
+JobSystem::JobSystem(unsigned int threads)
+{
+	if (threads == 0)
+	{
+		threads = std::thread::hardware_concurrency();
+	}
+
+	for (unsigned int i = 1; i < threads; i++)
+	{
+		workers.emplace_back(&JobSystem::work, this);
+	}
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+
+	start.notify_all();
+	for (auto& worker : workers)
+	{
+		worker.join();
+	}
+}
+
+/**
+*   @brief   Runs a batch of jobs across the pool.
+*   @details The workers are woken by bumping the generation, then the
+             caller claims indices alongside them. The batch is over
+             once every worker has run out of indices and checked in.
+*   @return  void
+*/
+void JobSystem::parallelFor(size_t count, const std::function<void(size_t)>& job)
+{
+	if (workers.empty() || count < 2)
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			job(i);
+		}
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		this->job = &job;
+		job_count = count;
+		next_job.store(0, std::memory_order_relaxed);
+		working = static_cast<unsigned int>(workers.size());
+		generation++;
+	}
+
+	start.notify_all();
+	runJobs();
+
+	std::unique_lock<std::mutex> lock(mutex);
+	done.wait(lock, [this] { return working == 0; });
+	this->job = nullptr;
+}
+
+unsigned int JobSystem::threads() const noexcept
+{
+	return static_cast<unsigned int>(workers.size()) + 1;
+}
+
+void JobSystem::work()
+{
+	unsigned int seen = 0;
+	for (;;)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			start.wait(lock, [this, seen] { return stopping || generation != seen; });
+			if (stopping)
+			{
+				return;
+			}
+			seen = generation;
+		}
+
+		runJobs();
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			working--;
+		}
+		done.notify_one();
+	}
+}
+
+void JobSystem::runJobs()
+{
+	for (size_t i = next_job.fetch_add(1); i < job_count; i = next_job.fetch_add(1))
+	{
+		(*job)(i);
+	}
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+*  A fixed pool of worker threads for data parallel work.
+*  parallelFor hands out indices to the workers and the calling thread
+*  until every index has run, then returns. Indices are claimed one at
+*  a time from a shared counter, so uneven jobs balance themselves. The
+*  workers sleep between calls.
+*/
+class JobSystem
+{
+public:
+
+	/**
+	*  Constructor.
+	*  @param [in] threads The number of threads to run jobs on, including
+	*  the calling thread. 0 uses one per hardware thread.
+	*/
+	explicit JobSystem(unsigned int threads = 0);
+	~JobSystem();
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	/**
+	*  Runs job(i) for every i below count and waits for them all.
+	*  Jobs may run in any order and on any thread, so they must not
+	*  touch the same data. Must not be called from inside a job.
+	*/
+	void parallelFor(size_t count, const std::function<void(size_t)>& job);
+
+	/**
+	*  Returns the number of threads jobs run on, including the caller.
+	*/
+	unsigned int threads() const noexcept;
+
+private:
+	void work();
+	void runJobs();
+
+	std::vector<std::thread> workers;
+	std::mutex mutex;
+	std::condition_variable start;
+	std::condition_variable done;
+	const std::function<void(size_t)>* job = nullptr;
+	size_t job_count = 0;
+	std::atomic<size_t> next_job{ 0 };
+	unsigned int generation = 0;
+	unsigned int working = 0;
+	bool stopping = false;
+};
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdint>
+
+/**
+*  On disk layout of a compiled level pack.
+*  Written by the LevelCompiler tool from the text levels in
+*  Resources/levels and mapped straight into memory by LevelPack, so
+*  every record is used in place. All values are little endian and
+*  every record is a multiple of four bytes, keeping the floats aligned
+*  in the mapping. The file starts with a Header, which is followed by
+*  the material table, the level table, the structure table and lastly
+*  a block of null terminated strings that the tables reference by
+*  offset. Each level owns a contiguous run of the structure table.
+*/
+namespace LevelFormat
+{
+	constexpr char     MAGIC[4] = { 'A', 'B', 'L', 'V' };
+	constexpr uint16_t VERSION  = 1;
+	constexpr uint32_t NO_STRING = 0xFFFFFFFF;
+
+#pragma pack(push, 1)
+	struct Header
+	{
+		char     magic[4];         /**< Always MAGIC. */
+		uint16_t version;          /**< Always VERSION. */
+		uint16_t level_count;      /**< Number of Level records. */
+		uint16_t material_count;   /**< Number of Material records. */
+		uint16_t reserved;
+		uint32_t structure_count;  /**< Number of Structure records, across every level. */
+		uint32_t string_bytes;     /**< Size of the string block. */
+	};
+
+	struct Material
+	{
+		uint32_t name;             /**< Offset of the material's name. */
+		uint32_t texture;          /**< Offset of the image file name, relative to Resources/images. */
+		uint32_t damaged_texture;  /**< Offset of the image shown once hit, or NO_STRING. */
+		uint16_t hit_points;       /**< Hits to destroy, 0 for scenery rocks pass through. */
+		uint16_t score;            /**< Points for each hit. */
+	};
+
+	struct Level
+	{
+		uint32_t name;             /**< Offset of the level's name. */
+		uint32_t first_structure;  /**< Index of the level's first Structure record. */
+		uint32_t structure_count;  /**< Number of Structure records in the level. */
+		float    king_x;           /**< Where the king stands. */
+		float    king_y;
+		float    army_x;           /**< Where the army starts its march. */
+		float    army_y;
+		uint16_t projectiles;      /**< Rocks the player has. */
+		uint16_t par_score;        /**< The score to aim for. */
+	};
+
+	struct Structure
+	{
+		float    x;                /**< Top left corner. */
+		float    y;
+		uint16_t material;         /**< Index of the Material record. */
+		uint16_t flags;            /**< Reserved, always 0. */
+	};
+#pragma pack(pop)
+
+	static_assert(sizeof(Header) == 20, "LevelFormat::Header layout changed");
+	static_assert(sizeof(Material) == 16, "LevelFormat::Material layout changed");
+	static_assert(sizeof(Level) == 32, "LevelFormat::Level layout changed");
+	static_assert(sizeof(Structure) == 12, "LevelFormat::Structure layout changed");
+}
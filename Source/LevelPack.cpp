@@ -0,0 +1,165 @@
+#include <algorithm>
+#include <cstring>
+#include "LevelPack.h"
+
+LevelPack::~LevelPack()
+{
+	unload();
+}
+
+/**
+*   @brief   Maps a level pack.
+*   @details The whole file is mapped read only and validated before
+             it is used, so a truncated or mismatched pack is
+             rejected rather than read out of bounds later.
+*   @return  True if successful.
+*/
+bool LevelPack::load(const std::string& file_name)
+{
+	unload();
+	if (!file.open(file_name))
+	{
+		return false;
+	}
+
+	data = file.data();
+	bytes = file.size();
+	if (!validate())
+	{
+		unload();
+		return false;
+	}
+
+	return true;
+}
+
+void LevelPack::unload()
+{
+	file.close();
+	data = nullptr;
+	bytes = 0;
+	header = nullptr;
+	materials = nullptr;
+	levels = nullptr;
+	structure_table = nullptr;
+	strings = nullptr;
+	max_structures = 0;
+}
+
+/**
+*   @brief   Checks the mapped file before it is used.
+*   @details The table sizes must add up to the file size, the
+             string block must end in a null, and every offset and
+             index in the tables must be in range. After this the
+             records are trusted without further checks.
+*   @return  True if the pack is valid.
+*/
+bool LevelPack::validate()
+{
+	using namespace LevelFormat;
+	if (bytes < sizeof(Header))
+	{
+		return false;
+	}
+
+	header = reinterpret_cast<const Header*>(data);
+	if (std::memcmp(header->magic, MAGIC, sizeof(header->magic)) ||
+		header->version != VERSION)
+	{
+		return false;
+	}
+
+	const size_t materials_offset = sizeof(Header);
+	const size_t levels_offset = materials_offset + header->material_count * sizeof(Material);
+	const size_t structures_offset = levels_offset + header->level_count * sizeof(Level);
+	const size_t strings_offset = structures_offset + size_t(header->structure_count) * sizeof(Structure);
+	if (strings_offset + header->string_bytes != bytes ||
+		!header->string_bytes || data[bytes - 1] != '\0')
+	{
+		return false;
+	}
+
+	materials = reinterpret_cast<const Material*>(data + materials_offset);
+	levels = reinterpret_cast<const Level*>(data + levels_offset);
+	structure_table = reinterpret_cast<const Structure*>(data + structures_offset);
+	strings = reinterpret_cast<const char*>(data + strings_offset);
+
+	auto validString = [this](uint32_t offset, bool optional)
+	{
+		return offset < header->string_bytes || (optional && offset == NO_STRING);
+	};
+
+	for (uint16_t i = 0; i < header->material_count; i++)
+	{
+		const Material& material = materials[i];
+		if (!validString(material.name, false) ||
+			!validString(material.texture, false) ||
+			!validString(material.damaged_texture, true))
+		{
+			return false;
+		}
+	}
+
+	for (uint32_t i = 0; i < header->structure_count; i++)
+	{
+		if (structure_table[i].material >= header->material_count)
+		{
+			return false;
+		}
+	}
+
+	for (uint16_t i = 0; i < header->level_count; i++)
+	{
+		const Level& level = levels[i];
+		if (!validString(level.name, false) ||
+			level.first_structure > header->structure_count ||
+			level.structure_count > header->structure_count - level.first_structure)
+		{
+			return false;
+		}
+
+		max_structures = std::max<size_t>(max_structures, level.structure_count);
+	}
+
+	return true;
+}
+
+bool LevelPack::isLoaded() const noexcept
+{
+	return header != nullptr;
+}
+
+size_t LevelPack::levelCount() const noexcept
+{
+	return header ? header->level_count : 0;
+}
+
+size_t LevelPack::materialCount() const noexcept
+{
+	return header ? header->material_count : 0;
+}
+
+size_t LevelPack::maxStructures() const noexcept
+{
+	return max_structures;
+}
+
+const LevelFormat::Level* LevelPack::level(size_t index) const noexcept
+{
+	return index < levelCount() ? &levels[index] : nullptr;
+}
+
+const LevelFormat::Structure* LevelPack::structures(const LevelFormat::Level& level) const noexcept
+{
+	return structure_table + level.first_structure;
+}
+
+const LevelFormat::Material& LevelPack::material(size_t index) const noexcept
+{
+	return materials[index];
+}
+
+const char* LevelPack::string(uint32_t offset) const noexcept
+{
+	return offset == LevelFormat::NO_STRING ? nullptr : strings + offset;
+}
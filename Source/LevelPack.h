@@ -0,0 +1,86 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include "LevelFormat.h"
+#include "MappedFile.h"
+
+/**
+*  A compiled level pack, mapped into memory.
+*  The file is validated once when it is loaded and from then on the
+*  records are read in place, with no parsing or copying. Switching
+*  level is just picking another Level record.
+*  @see LevelFormat
+*/
+class LevelPack
+{
+public:
+
+	/**
+	*  Default constructor.
+	*/
+	LevelPack() = default;
+
+	/**
+	*  Destructor. Unmaps the file.
+	*/
+	~LevelPack();
+
+	LevelPack(const LevelPack&) = delete;
+	LevelPack& operator=(const LevelPack&) = delete;
+
+	/**
+	*  Maps a pack written by the LevelCompiler tool.
+	*  Any pack already loaded is unmapped first.
+	*  @param [in] file_name The file path to the .lvl pack
+	*  @return true if the file was mapped and every record is valid
+	*/
+	bool load(const std::string& file_name);
+
+	/**
+	*  Unmaps the file. Pointers into it are invalidated.
+	*/
+	void unload();
+
+	bool isLoaded() const noexcept;
+	size_t levelCount() const noexcept;
+	size_t materialCount() const noexcept;
+
+	/**
+	*  Returns the most structures any one level has.
+	*/
+	size_t maxStructures() const noexcept;
+
+	/**
+	*  Returns a level, or nullptr if index is out of range.
+	*/
+	const LevelFormat::Level* level(size_t index) const noexcept;
+
+	/**
+	*  Returns the first of a level's structure_count structures.
+	*/
+	const LevelFormat::Structure* structures(const LevelFormat::Level& level) const noexcept;
+
+	/**
+	*  Returns a material. Structures' materials are always in range.
+	*/
+	const LevelFormat::Material& material(size_t index) const noexcept;
+
+	/**
+	*  Returns a string from the string block, or nullptr for NO_STRING.
+	*/
+	const char* string(uint32_t offset) const noexcept;
+
+private:
+	bool validate();
+
+	MappedFile file;
+	const unsigned char* data = nullptr;
+	size_t bytes = 0;
+
+	const LevelFormat::Header* header = nullptr;
+	const LevelFormat::Material* materials = nullptr;
+	const LevelFormat::Level* levels = nullptr;
+	const LevelFormat::Structure* structure_table = nullptr;
+	const char* strings = nullptr;
+	size_t max_structures = 0;
+};
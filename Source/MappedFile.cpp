@@ -0,0 +1,128 @@
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "MappedFile.h"
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+/**
+*   @brief   Maps a file.
+*   @details The mapping is private and read only. Empty files cannot
+             be mapped and are treated as missing.
+*   @return  True if successful.
+*/
+bool MappedFile::open(const std::string& file_name)
+{
+	close();
+	const std::string path = hostPath(file_name);
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+		nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER size;
+	HANDLE mapping = nullptr;
+	if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+	{
+		mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	}
+
+	if (!mapping)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	file_handle = file;
+	mapping_handle = mapping;
+	bytes = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+	length = bytes ? static_cast<size_t>(size.QuadPart) : 0;
+#else
+	const int file = ::open(path.c_str(), O_RDONLY);
+	if (file < 0)
+	{
+		return false;
+	}
+
+	struct stat info;
+	if (fstat(file, &info) == 0 && info.st_size > 0)
+	{
+		void* mapped = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+		if (mapped != MAP_FAILED)
+		{
+			bytes = static_cast<const unsigned char*>(mapped);
+			length = static_cast<size_t>(info.st_size);
+		}
+	}
+
+	//the mapping stays valid once the file is closed
+	::close(file);
+#endif
+
+	if (!bytes)
+	{
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+void MappedFile::close()
+{
+#ifdef _WIN32
+	if (bytes)
+	{
+		UnmapViewOfFile(bytes);
+	}
+
+	if (mapping_handle)
+	{
+		CloseHandle(mapping_handle);
+	}
+
+	if (file_handle)
+	{
+		CloseHandle(file_handle);
+	}
+
+	file_handle = nullptr;
+	mapping_handle = nullptr;
+#else
+	if (bytes)
+	{
+		munmap(const_cast<unsigned char*>(bytes), length);
+	}
+#endif
+
+	bytes = nullptr;
+	length = 0;
+}
+
+bool MappedFile::isOpen() const noexcept
+{
+	return bytes != nullptr;
+}
+
+const unsigned char* MappedFile::data() const noexcept
+{
+	return bytes;
+}
+
+size_t MappedFile::size() const noexcept
+{
+	return length;
+}
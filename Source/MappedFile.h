@@ -0,0 +1,68 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <string>
+
+/**
+*  Converts a game path into one the host can open.
+*  The game's paths use back slashes, which only Windows treats as a
+*  separator, while every host accepts forward slashes. The result is
+*  also the form the cooked texture index and the texture caches key
+*  their files by.
+*  @param [in] file_name The path as the game writes it
+*  @return the path with forward slashes
+*/
+inline std::string hostPath(const std::string& file_name)
+{
+	std::string path = file_name;
+	std::replace(path.begin(), path.end(), '\\', '/');
+	return path;
+}
+
+/**
+*  A file mapped read only into memory.
+*  Uses mmap, or a file mapping on Windows, so the file's pages are
+*  only read when they are touched and are shared with the system's
+*  file cache rather than copied into the heap.
+*/
+class MappedFile
+{
+public:
+
+	/**
+	*  Default constructor.
+	*/
+	MappedFile() = default;
+
+	/**
+	*  Destructor. Unmaps the file.
+	*/
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/**
+	*  Maps a file. Any file already mapped is unmapped first.
+	*  @param [in] file_name The file path, back slashes are accepted
+	*  @return true if the file exists, is not empty and was mapped
+	*/
+	bool open(const std::string& file_name);
+
+	/**
+	*  Unmaps the file. Pointers into it are invalidated.
+	*/
+	void close();
+
+	bool isOpen() const noexcept;
+	const unsigned char* data() const noexcept;
+	size_t size() const noexcept;
+
+private:
+	const unsigned char* bytes = nullptr;
+	size_t length = 0;
+#ifdef _WIN32
+	void* file_handle = nullptr;
+	void* mapping_handle = nullptr;
+#endif
+};
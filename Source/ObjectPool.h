@@ -0,0 +1,153 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+/**
+*  Counters describing a pool.
+*  allocations and heap_fallbacks are cumulative, in_use and
+*  high_water describe the objects currently handed out.
+*/
+struct PoolStats
+{
+	const char* name = "";
+	size_t capacity = 0;        /**< Objects the pool can hold without the heap. */
+	size_t in_use = 0;          /**< Objects handed out and not yet returned. */
+	size_t high_water = 0;      /**< The most objects ever in use at once. */
+	size_t allocations = 0;     /**< Requests made of the pool. */
+	size_t heap_fallbacks = 0;  /**< Requests the pool could not serve, which went to the heap. */
+};
+
+/**
+*  A fixed capacity pool of objects of one type.
+*  Every object lives in a single slab allocated up front and aligned to
+*  a cache line, with a free list of slots, so creating and destroying
+*  objects never touches the heap once the pool exists. Requests beyond
+*  the capacity fall back to new and delete and are counted, so a pool
+*  that is too small shows up in its stats rather than failing.
+*/
+template <typename T>
+class ObjectPool
+{
+public:
+	static constexpr size_t CACHE_LINE = 64;
+	static_assert(alignof(T) <= CACHE_LINE, "ObjectPool slots are at most cache line aligned");
+
+	/**
+	*  Constructor.
+	*  @param [in] capacity The number of objects held in the slab.
+	*  @param [in] name A name for the stats, which must outlive the pool.
+	*/
+	explicit ObjectPool(size_t capacity, const char* name = "")
+		: used(capacity, 0)
+	{
+		counters.name = name;
+		counters.capacity = capacity;
+
+		//one spare line so the first slot can start on a line boundary
+		size_t space = capacity * sizeof(T) + CACHE_LINE;
+		memory.reset(new unsigned char[space]);
+		void* start = memory.get();
+		slots = static_cast<unsigned char*>(std::align(CACHE_LINE, capacity * sizeof(T), start, space));
+
+		//hand out the lowest slots first
+		free_slots.reserve(capacity);
+		for (size_t slot = capacity; slot > 0; slot--)
+		{
+			free_slots.push_back(static_cast<uint32_t>(slot - 1));
+		}
+	}
+
+	/**
+	*  Destructor. Destroys any objects still in the slab.
+	*/
+	~ObjectPool()
+	{
+		for (size_t slot = 0; slot < used.size(); slot++)
+		{
+			if (used[slot])
+			{
+				reinterpret_cast<T*>(slots + slot * sizeof(T))->~T();
+			}
+		}
+	}
+
+	ObjectPool(const ObjectPool&) = delete;
+	ObjectPool& operator=(const ObjectPool&) = delete;
+
+	/**
+	*  Constructs an object in a free slot, or on the heap if there
+	*  are none.
+	*/
+	template <typename... Args>
+	T* create(Args&&... args)
+	{
+		counters.allocations++;
+		if (free_slots.empty())
+		{
+			counters.heap_fallbacks++;
+			return new T(std::forward<Args>(args)...);
+		}
+
+		const uint32_t slot = free_slots.back();
+		T* object = new (slots + slot * sizeof(T)) T(std::forward<Args>(args)...);
+		free_slots.pop_back();
+		used[slot] = 1;
+
+		counters.in_use++;
+		if (counters.in_use > counters.high_water)
+		{
+			counters.high_water = counters.in_use;
+		}
+
+		return object;
+	}
+
+	/**
+	*  Destroys an object made by create and frees its slot.
+	*/
+	void destroy(T* object)
+	{
+		if (!object)
+		{
+			return;
+		}
+
+		if (!owns(object))
+		{
+			delete object;
+			return;
+		}
+
+		const size_t slot = (reinterpret_cast<unsigned char*>(object) - slots) / sizeof(T);
+		object->~T();
+		used[slot] = 0;
+		free_slots.push_back(static_cast<uint32_t>(slot));
+		counters.in_use--;
+	}
+
+	/**
+	*  Returns true if an object lives in this pool's slab.
+	*/
+	bool owns(const T* object) const noexcept
+	{
+		const std::less<const void*> before;
+		return !before(object, slots) && before(object, slots + used.size() * sizeof(T));
+	}
+
+	const PoolStats& stats() const noexcept
+	{
+		return counters;
+	}
+
+private:
+	std::unique_ptr<unsigned char[]> memory;
+	unsigned char* slots = nullptr;
+	std::vector<uint32_t> free_slots;
+	std::vector<uint8_t> used;
+	PoolStats counters;
+};
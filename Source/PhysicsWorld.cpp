@@ -0,0 +1,695 @@
+#include <algorithm>
+#include <cmath>
+#include "JobSystem.h"
+#include "PhysicsWorld.h"
+
+namespace
+{
+	uint64_t pairKey(int a, int b) noexcept
+	{
+		return (static_cast<uint64_t>(static_cast<uint32_t>(a)) << 32) | static_cast<uint32_t>(b);
+	}
+}
+
+PhysicsWorld::PhysicsWorld(float gravity)
+	: gravity(gravity)
+{
+}
+
+int PhysicsWorld::addBody(const BodyDef& def)
+{
+	int id;
+	if (!free_ids.empty())
+	{
+		id = free_ids.back();
+		free_ids.pop_back();
+	}
+	else
+	{
+		id = static_cast<int>(alive.size());
+		centre_x.push_back(0);
+		centre_y.push_back(0);
+		half_width.push_back(0);
+		half_height.push_back(0);
+		velocity_x.push_back(0);
+		velocity_y.push_back(0);
+		inverse_mass.push_back(0);
+		restitution.push_back(0);
+		friction.push_back(0);
+		gravity_scale.push_back(0);
+		sleep_timer.push_back(0);
+		category.push_back(0);
+		collides_with.push_back(0);
+		alive.push_back(0);
+		awake.push_back(0);
+		left_edge.push_back(0);
+		parent.push_back(0);
+		island_index.push_back(-1);
+		island_sleep.push_back(0);
+	}
+
+	half_width[id] = def.bounds.length * 0.5f;
+	half_height[id] = def.bounds.height * 0.5f;
+	centre_x[id] = def.bounds.x + half_width[id];
+	centre_y[id] = def.bounds.y + half_height[id];
+	velocity_x[id] = def.velocity_x;
+	velocity_y[id] = def.velocity_y;
+	inverse_mass[id] = def.mass > 0 ? 1.0f / def.mass : 0.0f;
+	restitution[id] = def.restitution;
+	friction[id] = def.friction;
+	gravity_scale[id] = def.gravity_scale;
+	sleep_timer[id] = 0;
+	category[id] = def.category;
+	collides_with[id] = def.mask;
+	alive[id] = 1;
+	awake[id] = def.mass > 0 && def.awake;
+	order.push_back(id);
+	alive_count++;
+	return id;
+}
+
+/**
+*   @brief   Removes a body.
+*   @details Anything resting on the body would otherwise sleep in
+             mid air, so every body it touches is woken first. The id
+             leaves the sweep order and the warm start cache straight
+             away, as addBody may hand it out again before the next
+             step.
+*   @return  void
+*/
+void PhysicsWorld::removeBody(int id)
+{
+	if (!isAlive(id))
+	{
+		return;
+	}
+
+	for (int other : order)
+	{
+		if (other != id && alive[other] &&
+			std::abs(centre_x[other] - centre_x[id]) <= half_width[other] + half_width[id] + slop &&
+			std::abs(centre_y[other] - centre_y[id]) <= half_height[other] + half_height[id] + slop)
+		{
+			wake(other);
+		}
+	}
+
+	order.erase(std::find(order.begin(), order.end(), id));
+	cache.erase(std::remove_if(cache.begin(), cache.end(), [id](const Cached& cached)
+	{
+		return static_cast<int>(cached.key >> 32) == id ||
+			static_cast<int>(cached.key & 0xffffffffu) == id;
+	}), cache.end());
+
+	alive[id] = 0;
+	awake[id] = 0;
+	free_ids.push_back(id);
+	alive_count--;
+}
+
+void PhysicsWorld::clear()
+{
+	centre_x.clear();
+	centre_y.clear();
+	half_width.clear();
+	half_height.clear();
+	velocity_x.clear();
+	velocity_y.clear();
+	inverse_mass.clear();
+	restitution.clear();
+	friction.clear();
+	gravity_scale.clear();
+	sleep_timer.clear();
+	category.clear();
+	collides_with.clear();
+	alive.clear();
+	awake.clear();
+	free_ids.clear();
+	order.clear();
+	left_edge.clear();
+	parent.clear();
+	island_index.clear();
+	island_sleep.clear();
+	solves.clear();
+	cache.clear();
+	reported.clear();
+	alive_count = 0;
+	step_stats = Stats();
+}
+
+/**
+*   @brief   Advances the world by one step.
+*   @details Velocities are integrated before the contacts are
+             solved and positions after, so a resting body's gravity
+             is cancelled by its contacts within the same step.
+*   @return  void
+*/
+void PhysicsWorld::step(float dt)
+{
+	if (dt <= 0)
+	{
+		return;
+	}
+
+	step_stats = Stats();
+	integrateVelocities(dt);
+	findContacts(dt);
+	buildIslands();
+	solveIslands();
+	integratePositions(dt);
+	updateSleep(dt);
+	cacheImpulses();
+
+	step_stats.bodies = alive_count;
+	step_stats.contacts = solves.size();
+}
+
+bool PhysicsWorld::isAlive(int id) const noexcept
+{
+	return id >= 0 && static_cast<size_t>(id) < alive.size() && alive[id];
+}
+
+bool PhysicsWorld::isAwake(int id) const noexcept
+{
+	return isAlive(id) && awake[id];
+}
+
+bool PhysicsWorld::isStatic(int id) const noexcept
+{
+	return isAlive(id) && inverse_mass[id] == 0;
+}
+
+void PhysicsWorld::wake(int id)
+{
+	if (isAlive(id) && inverse_mass[id] > 0)
+	{
+		awake[id] = 1;
+		sleep_timer[id] = 0;
+	}
+}
+
+rect PhysicsWorld::bounds(int id) const
+{
+	rect box;
+	box.x = centre_x[id] - half_width[id];
+	box.y = centre_y[id] - half_height[id];
+	box.length = half_width[id] * 2;
+	box.height = half_height[id] * 2;
+	return box;
+}
+
+void PhysicsWorld::setPosition(int id, float x, float y)
+{
+	centre_x[id] = x + half_width[id];
+	centre_y[id] = y + half_height[id];
+	wake(id);
+}
+
+float PhysicsWorld::velocityX(int id) const
+{
+	return velocity_x[id];
+}
+
+float PhysicsWorld::velocityY(int id) const
+{
+	return velocity_y[id];
+}
+
+void PhysicsWorld::setVelocity(int id, float vx, float vy)
+{
+	velocity_x[id] = vx;
+	velocity_y[id] = vy;
+	wake(id);
+}
+
+void PhysicsWorld::applyImpulse(int id, float impulse_x, float impulse_y)
+{
+	if (isAlive(id) && inverse_mass[id] > 0)
+	{
+		velocity_x[id] += impulse_x * inverse_mass[id];
+		velocity_y[id] += impulse_y * inverse_mass[id];
+		wake(id);
+	}
+}
+
+void PhysicsWorld::setJobSystem(JobSystem* jobs) noexcept
+{
+	this->jobs = jobs;
+}
+
+const std::vector<PhysicsWorld::Contact>& PhysicsWorld::contacts() const noexcept
+{
+	return reported;
+}
+
+const PhysicsWorld::Stats& PhysicsWorld::stats() const noexcept
+{
+	return step_stats;
+}
+
+void PhysicsWorld::integrateVelocities(float dt)
+{
+	for (int id : order)
+	{
+		if (awake[id])
+		{
+			velocity_y[id] += gravity * gravity_scale[id] * dt;
+			step_stats.awake++;
+		}
+	}
+}
+
+/**
+*   @brief   Finds the touching pairs.
+*   @details The ids are kept sorted by left edge with an insertion
+             sort, which is close to linear as bodies barely move
+             between steps. Each body is then only compared with
+             those whose left edge lies before its right edge. Pairs
+             with nothing awake and moving, or whose categories do
+             not collide, are skipped outright. Sleeping bodies are
+             woken before any contact is built, so none is solved as
+             immovable in one contact and moved by another.
+*   @return  void
+*/
+void PhysicsWorld::findContacts(float dt)
+{
+	solves.clear();
+
+	//refresh the sort keys
+	for (int id : order)
+	{
+		left_edge[id] = centre_x[id] - half_width[id];
+	}
+
+	for (size_t i = 1; i < order.size(); i++)
+	{
+		const int id = order[i];
+		const float key = left_edge[id];
+		size_t j = i;
+		for (; j > 0 && left_edge[order[j - 1]] > key; j--)
+		{
+			order[j] = order[j - 1];
+		}
+		order[j] = id;
+	}
+
+	wakeTouched();
+
+	for (size_t i = 0; i < order.size(); i++)
+	{
+		const int a = order[i];
+		const float right = centre_x[a] + half_width[a] + slop;
+		for (size_t j = i + 1; j < order.size() && left_edge[order[j]] <= right; j++)
+		{
+			const int b = order[j];
+			if (!isDynamicAndAwake(a) && !isDynamicAndAwake(b))
+			{
+				continue;
+			}
+
+			if (!(category[a] & collides_with[b]) || !(category[b] & collides_with[a]))
+			{
+				continue;
+			}
+
+			step_stats.pairs++;
+			if (std::abs(centre_y[b] - centre_y[a]) > half_height[a] + half_height[b])
+			{
+				continue;
+			}
+
+			addContact(std::min(a, b), std::max(a, b), dt);
+		}
+	}
+}
+
+/**
+*   @brief   Wakes sleeping bodies that something fast is touching.
+*   @details Runs the same sweep as findContacts, but only over pairs
+             with a fast awake body in them. Woken bodies can be
+             moving too, if their velocity was set while they slept,
+             so the sweep repeats until it wakes nothing fast.
+*   @return  void
+*/
+void PhysicsWorld::wakeTouched()
+{
+	const float fast = wake_speed * wake_speed;
+	bool woke_fast = true;
+	while (woke_fast)
+	{
+		woke_fast = false;
+		for (size_t i = 0; i < order.size(); i++)
+		{
+			const int a = order[i];
+			const float right = centre_x[a] + half_width[a];
+			for (size_t j = i + 1; j < order.size() && left_edge[order[j]] < right; j++)
+			{
+				const int b = order[j];
+				if (awake[a] == awake[b] ||
+					!(category[a] & collides_with[b]) || !(category[b] & collides_with[a]) ||
+					std::abs(centre_y[b] - centre_y[a]) >= half_height[a] + half_height[b])
+				{
+					continue;
+				}
+
+				const int moving = awake[a] ? a : b;
+				const int sleeping = awake[a] ? b : a;
+				if (inverse_mass[sleeping] > 0 && speedSquared(moving) > fast)
+				{
+					wake(sleeping);
+					woke_fast = woke_fast || speedSquared(sleeping) > fast;
+				}
+			}
+		}
+	}
+}
+
+/**
+*   @brief   Builds the contact between two overlapping bodies.
+*   @details The normal is along the axis of least penetration. Bodies
+             still asleep after wakeTouched are treated as static, so
+             a settled stack stays asleep while something slow comes
+             to rest on it.
+*   @return  void
+*/
+void PhysicsWorld::addContact(int a, int b, float dt)
+{
+	const float dx = centre_x[b] - centre_x[a];
+	const float dy = centre_y[b] - centre_y[a];
+	const float overlap_x = half_width[a] + half_width[b] - std::abs(dx);
+	const float overlap_y = half_height[a] + half_height[b] - std::abs(dy);
+	if (overlap_x <= 0 || overlap_y <= 0)
+	{
+		return;
+	}
+
+	Solve solve;
+	solve.a = a;
+	solve.b = b;
+	if (overlap_x < overlap_y)
+	{
+		solve.normal_x = dx < 0 ? -1.0f : 1.0f;
+		solve.normal_y = 0;
+		solve.depth = overlap_x;
+	}
+	else
+	{
+		solve.normal_x = 0;
+		solve.normal_y = dy < 0 ? -1.0f : 1.0f;
+		solve.depth = overlap_y;
+	}
+
+	solve.inverse_mass_a = awake[a] ? inverse_mass[a] : 0.0f;
+	solve.inverse_mass_b = awake[b] ? inverse_mass[b] : 0.0f;
+	const float inverse_sum = solve.inverse_mass_a + solve.inverse_mass_b;
+	if (inverse_sum == 0)
+	{
+		return;
+	}
+
+	solve.normal_mass = 1.0f / inverse_sum;
+	solve.friction = std::sqrt(friction[a] * friction[b]);
+	solve.bias = correction / dt * std::max(solve.depth - slop, 0.0f);
+
+	const float approach =
+		(velocity_x[b] - velocity_x[a]) * solve.normal_x +
+		(velocity_y[b] - velocity_y[a]) * solve.normal_y;
+	solve.bounce = approach < -bounce_speed ? -std::max(restitution[a], restitution[b]) * approach : 0.0f;
+
+	solve.key = pairKey(a, b);
+	solve.normal_impulse = 0;
+	solve.tangent_impulse = 0;
+	solves.push_back(solve);
+}
+
+/**
+*   @brief   Groups the contacts into islands.
+*   @details Awake bodies touching through a contact are joined with
+             a union-find. Static and sleeping bodies are solved as
+             immovable, so they do not join islands together. Each
+             island's contacts are then moved next to each other,
+             keeping the order they were found in.
+*   @return  void
+*/
+void PhysicsWorld::buildIslands()
+{
+	for (int id : order)
+	{
+		parent[id] = id;
+		island_index[id] = -1;
+	}
+
+	for (const Solve& solve : solves)
+	{
+		if (solve.inverse_mass_a > 0 && solve.inverse_mass_b > 0)
+		{
+			const int a = findRoot(solve.a);
+			const int b = findRoot(solve.b);
+			if (a != b)
+			{
+				parent[std::max(a, b)] = std::min(a, b);
+			}
+		}
+	}
+
+	//number the islands in the order their first contact was found
+	island_start.assign(1, 0);
+	std::vector<size_t>& counts = island_schedule;
+	counts.clear();
+	for (const Solve& solve : solves)
+	{
+		const int root = findRoot(solve.inverse_mass_a > 0 ? solve.a : solve.b);
+		if (island_index[root] < 0)
+		{
+			island_index[root] = static_cast<int>(counts.size());
+			counts.push_back(0);
+		}
+		counts[island_index[root]]++;
+	}
+
+	for (size_t count : counts)
+	{
+		island_start.push_back(island_start.back() + count);
+	}
+
+	sorted_solves.resize(solves.size());
+	std::vector<size_t>& fill = counts;
+	std::copy(island_start.begin(), island_start.end() - 1, fill.begin());
+	for (const Solve& solve : solves)
+	{
+		const int root = findRoot(solve.inverse_mass_a > 0 ? solve.a : solve.b);
+		sorted_solves[fill[island_index[root]]++] = solve;
+	}
+
+	solves.swap(sorted_solves);
+	step_stats.islands = island_start.size() - 1;
+}
+
+/**
+*   @brief   Solves every island.
+*   @details The largest islands are handed out first so one big
+             tower does not start last and hold up the step.
+*   @return  void
+*/
+void PhysicsWorld::solveIslands()
+{
+	const size_t islands = island_start.size() - 1;
+	if (!jobs || jobs->threads() < 2 || islands < 2 || solves.size() < parallel_contacts)
+	{
+		for (size_t island = 0; island < islands; island++)
+		{
+			solveIsland(island);
+		}
+		return;
+	}
+
+	island_schedule.resize(islands);
+	for (size_t island = 0; island < islands; island++)
+	{
+		island_schedule[island] = island;
+	}
+
+	std::sort(island_schedule.begin(), island_schedule.end(), [this](size_t lhs, size_t rhs)
+	{
+		const size_t lhs_size = island_start[lhs + 1] - island_start[lhs];
+		const size_t rhs_size = island_start[rhs + 1] - island_start[rhs];
+		return lhs_size != rhs_size ? lhs_size > rhs_size : lhs < rhs;
+	});
+
+	jobs->parallelFor(islands, [this](size_t job) { solveIsland(island_schedule[job]); });
+	step_stats.parallel = true;
+}
+
+/**
+*   @brief   Warm starts and resolves one island's contacts.
+*   @details Last step's impulses are reapplied to contacts that
+             persist, then the contacts are resolved with sequential
+             impulses. Accumulated impulses are clamped rather than
+             each increment, so later iterations can take back what
+             earlier ones overdid. Friction is limited by the normal
+             impulse. Immovable bodies are never written to, as other
+             islands may be reading them.
+*   @return  void
+*/
+void PhysicsWorld::solveIsland(size_t island)
+{
+	Solve* const begin = solves.data() + island_start[island];
+	Solve* const end = solves.data() + island_start[island + 1];
+
+	auto apply = [this](const Solve& solve, float impulse_x, float impulse_y)
+	{
+		if (solve.inverse_mass_a > 0)
+		{
+			velocity_x[solve.a] -= impulse_x * solve.inverse_mass_a;
+			velocity_y[solve.a] -= impulse_y * solve.inverse_mass_a;
+		}
+		if (solve.inverse_mass_b > 0)
+		{
+			velocity_x[solve.b] += impulse_x * solve.inverse_mass_b;
+			velocity_y[solve.b] += impulse_y * solve.inverse_mass_b;
+		}
+	};
+
+	for (Solve* solve = begin; solve != end; solve++)
+	{
+		auto found = std::lower_bound(cache.begin(), cache.end(), solve->key,
+			[](const Cached& cached, uint64_t key) { return cached.key < key; });
+		if (found == cache.end() || found->key != solve->key)
+		{
+			continue;
+		}
+
+		solve->normal_impulse = found->normal_impulse;
+		solve->tangent_impulse = found->tangent_impulse;
+		apply(*solve,
+			solve->normal_x * solve->normal_impulse - solve->normal_y * solve->tangent_impulse,
+			solve->normal_y * solve->normal_impulse + solve->normal_x * solve->tangent_impulse);
+	}
+
+	for (int iteration = 0; iteration < iterations; iteration++)
+	{
+		for (Solve* solve = begin; solve != end; solve++)
+		{
+			const int a = solve->a;
+			const int b = solve->b;
+			const float tangent_x = -solve->normal_y;
+			const float tangent_y = solve->normal_x;
+
+			//normal
+			float relative_x = velocity_x[b] - velocity_x[a];
+			float relative_y = velocity_y[b] - velocity_y[a];
+			const float normal_speed = relative_x * solve->normal_x + relative_y * solve->normal_y;
+			float impulse = solve->normal_mass * (-normal_speed + solve->bias + solve->bounce);
+			const float total = std::max(solve->normal_impulse + impulse, 0.0f);
+			impulse = total - solve->normal_impulse;
+			solve->normal_impulse = total;
+			apply(*solve, solve->normal_x * impulse, solve->normal_y * impulse);
+
+			//friction
+			relative_x = velocity_x[b] - velocity_x[a];
+			relative_y = velocity_y[b] - velocity_y[a];
+			const float tangent_speed = relative_x * tangent_x + relative_y * tangent_y;
+			const float limit = solve->friction * solve->normal_impulse;
+			float friction_impulse = -solve->normal_mass * tangent_speed;
+			const float friction_total = std::max(-limit, std::min(solve->tangent_impulse + friction_impulse, limit));
+			friction_impulse = friction_total - solve->tangent_impulse;
+			solve->tangent_impulse = friction_total;
+			apply(*solve, tangent_x * friction_impulse, tangent_y * friction_impulse);
+		}
+	}
+}
+
+void PhysicsWorld::integratePositions(float dt)
+{
+	for (int id : order)
+	{
+		if (awake[id])
+		{
+			centre_x[id] += velocity_x[id] * dt;
+			centre_y[id] += velocity_y[id] * dt;
+		}
+	}
+}
+
+/**
+*   @brief   Puts still islands to sleep.
+*   @details Each body times how long it has been slow. An island
+             sleeps once its most recently moving body has been slow
+             for sleep_delay, so a stack never sleeps from the bottom
+             up while the top is still settling.
+*   @return  void
+*/
+void PhysicsWorld::updateSleep(float dt)
+{
+	const float limit = sleep_speed * sleep_speed;
+	for (int id : order)
+	{
+		if (awake[id])
+		{
+			sleep_timer[id] = speedSquared(id) > limit ? 0 : sleep_timer[id] + dt;
+			island_sleep[findRoot(id)] = sleep_delay;
+		}
+	}
+
+	for (int id : order)
+	{
+		if (awake[id])
+		{
+			float& island = island_sleep[findRoot(id)];
+			island = std::min(island, sleep_timer[id]);
+		}
+	}
+
+	for (int id : order)
+	{
+		if (awake[id] && island_sleep[findRoot(id)] >= sleep_delay)
+		{
+			awake[id] = 0;
+			velocity_x[id] = 0;
+			velocity_y[id] = 0;
+		}
+	}
+}
+
+void PhysicsWorld::cacheImpulses()
+{
+	cache.clear();
+	reported.clear();
+	for (const Solve& solve : solves)
+	{
+		cache.push_back({ solve.key, solve.normal_impulse, solve.tangent_impulse });
+
+		Contact contact;
+		contact.a = solve.a;
+		contact.b = solve.b;
+		contact.normal_x = solve.normal_x;
+		contact.normal_y = solve.normal_y;
+		contact.depth = solve.depth;
+		contact.impulse = solve.normal_impulse;
+		reported.push_back(contact);
+	}
+
+	std::sort(cache.begin(), cache.end(),
+		[](const Cached& lhs, const Cached& rhs) { return lhs.key < rhs.key; });
+}
+
+int PhysicsWorld::findRoot(int id) noexcept
+{
+	while (parent[id] != id)
+	{
+		parent[id] = parent[parent[id]];
+		id = parent[id];
+	}
+
+	return id;
+}
+
+bool PhysicsWorld::isDynamicAndAwake(int id) const noexcept
+{
+	return awake[id] != 0;
+}
+
+float PhysicsWorld::speedSquared(int id) const noexcept
+{
+	return velocity_x[id] * velocity_x[id] + velocity_y[id] * velocity_y[id];
+}
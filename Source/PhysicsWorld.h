@@ -0,0 +1,242 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Rect.h"
+
+class JobSystem;
+
+/**
+*  Rigid body physics for axis aligned boxes.
+*  Bodies are stored as structure of arrays and referred to by id. Each
+*  step applies gravity, finds touching pairs by sorting the bodies
+*  along x and sweeping, then resolves the contacts with sequential
+*  impulses, warm started from the previous step so stacks settle and
+*  stay put. Bodies that have been still for a while are put to sleep
+*  and cost next to nothing until something hits them hard enough to
+*  wake them. Bodies do not rotate, which suits crates, planks and
+*  projectiles on a side on screen. Each body has collision category
+*  bits and a mask of the categories it collides with, so a body can
+*  fly through the world without touching anything in it.
+*
+*  Bodies joined by contacts form islands, found each step with a
+*  union-find. Islands share no moving bodies, so given a JobSystem
+*  they are solved on different threads. Each island is always solved
+*  by one thread in the same order, so the results are bit for bit the
+*  same however many threads there are. Islands also sleep as a whole,
+*  once every body in them has been still for sleep_delay.
+*
+*  Units are pixels and seconds, with y pointing down the screen.
+*/
+class PhysicsWorld
+{
+public:
+
+	/**
+	*  Describes a body to add.
+	*/
+	struct BodyDef
+	{
+		rect bounds;                /**< Position and size. */
+		float mass = 1.0f;          /**< Zero for a static body. */
+		float restitution = 0.1f;   /**< Bounciness, 0 to 1. */
+		float friction = 0.6f;      /**< Coulomb friction coefficient. */
+		float gravity_scale = 1.0f; /**< Multiplies the world's gravity. */
+		float velocity_x = 0;
+		float velocity_y = 0;
+		uint16_t category = 1;      /**< The categories the body belongs to. */
+		uint16_t mask = 0xFFFF;     /**< The categories it collides with. */
+		bool awake = true;          /**< False to add a body already at rest, e.g. on a level's structures. */
+	};
+
+	/**
+	*  A touching pair from the last step.
+	*  The normal points from a to b.
+	*/
+	struct Contact
+	{
+		int a = -1;
+		int b = -1;
+		float normal_x = 0;
+		float normal_y = 0;
+		float depth = 0;
+		float impulse = 0;          /**< The normal impulse applied. */
+	};
+
+	/**
+	*  Counters describing the last step.
+	*/
+	struct Stats
+	{
+		size_t bodies = 0;
+		size_t awake = 0;
+		size_t pairs = 0;           /**< Pairs tested after the sweep. */
+		size_t contacts = 0;
+		size_t islands = 0;         /**< Islands with at least one contact. */
+		bool parallel = false;      /**< Whether the islands were solved on the job system. */
+	};
+
+	/**
+	*  Constructor.
+	*  @param [in] gravity Downwards acceleration in pixels per second squared.
+	*/
+	explicit PhysicsWorld(float gravity = 980.0f);
+
+	/**
+	*  Adds a body.
+	*  @return The body's id. Ids of removed bodies are reused.
+	*/
+	int addBody(const BodyDef& def);
+
+	/**
+	*  Removes a body and wakes anything touching it.
+	*/
+	void removeBody(int id);
+
+	/**
+	*  Removes every body.
+	*/
+	void clear();
+
+	/**
+	*  Advances the world.
+	*  @param [in] dt The step length in seconds, ideally fixed.
+	*/
+	void step(float dt);
+
+	bool isAlive(int id) const noexcept;
+	bool isAwake(int id) const noexcept;
+	bool isStatic(int id) const noexcept;
+
+	/**
+	*  Wakes a sleeping body.
+	*/
+	void wake(int id);
+
+	/**
+	*  Returns a body's position and size.
+	*/
+	rect bounds(int id) const;
+
+	/**
+	*  Moves a body's top left corner, waking it.
+	*/
+	void setPosition(int id, float x, float y);
+
+	float velocityX(int id) const;
+	float velocityY(int id) const;
+
+	/**
+	*  Sets a body's velocity, waking it.
+	*/
+	void setVelocity(int id, float vx, float vy);
+
+	/**
+	*  Changes a body's velocity by an impulse over its mass, waking it.
+	*  Static bodies are not moved.
+	*/
+	void applyImpulse(int id, float impulse_x, float impulse_y);
+
+	/**
+	*  Solves islands in parallel on a job system, or serially if null.
+	*  The job system must outlive the world or be replaced first.
+	*/
+	void setJobSystem(JobSystem* jobs) noexcept;
+
+	/**
+	*  Returns the contacts resolved by the last step, grouped by island.
+	*/
+	const std::vector<Contact>& contacts() const noexcept;
+
+	/**
+	*  Returns the counters for the last step.
+	*/
+	const Stats& stats() const noexcept;
+
+	float gravity;
+	int iterations = 10;            /**< Velocity iterations per step. */
+	float slop = 0.5f;              /**< Penetration left alone, keeps resting contacts touching. */
+	float correction = 0.2f;        /**< Fraction of the remaining penetration removed per step. */
+	float bounce_speed = 60.0f;     /**< Slower impacts do not bounce. */
+	float sleep_speed = 6.0f;       /**< Bodies slower than this may sleep. */
+	float sleep_delay = 0.5f;       /**< How long a body must be slow before it sleeps. */
+	float wake_speed = 30.0f;       /**< Bodies faster than this wake what they touch. */
+	size_t parallel_contacts = 256; /**< Fewer contacts than this are solved on one thread. */
+
+private:
+	struct Solve
+	{
+		int a;
+		int b;
+		float normal_x;
+		float normal_y;
+		float depth;
+		float inverse_mass_a;
+		float inverse_mass_b;
+		float normal_mass;
+		float friction;
+		float bias;
+		float bounce;
+		float normal_impulse;
+		float tangent_impulse;
+		uint64_t key;
+	};
+
+	struct Cached
+	{
+		uint64_t key;
+		float normal_impulse;
+		float tangent_impulse;
+	};
+
+	void integrateVelocities(float dt);
+	void findContacts(float dt);
+	void wakeTouched();
+	void addContact(int a, int b, float dt);
+	void buildIslands();
+	void solveIslands();
+	void solveIsland(size_t island);
+	int findRoot(int id) noexcept;
+	void integratePositions(float dt);
+	void updateSleep(float dt);
+	void cacheImpulses();
+	bool isDynamicAndAwake(int id) const noexcept;
+	float speedSquared(int id) const noexcept;
+
+	//bodies, centres and half sizes
+	std::vector<float> centre_x;
+	std::vector<float> centre_y;
+	std::vector<float> half_width;
+	std::vector<float> half_height;
+	std::vector<float> velocity_x;
+	std::vector<float> velocity_y;
+	std::vector<float> inverse_mass;
+	std::vector<float> restitution;
+	std::vector<float> friction;
+	std::vector<float> gravity_scale;
+	std::vector<float> sleep_timer;
+	std::vector<uint16_t> category;
+	std::vector<uint16_t> collides_with;
+	std::vector<uint8_t> alive;
+	std::vector<uint8_t> awake;
+	std::vector<int> free_ids;
+	size_t alive_count = 0;
+
+	//the sweep, body ids sorted by their left edge
+	std::vector<int> order;
+	std::vector<float> left_edge;
+
+	std::vector<Solve> solves;
+	std::vector<Solve> sorted_solves;
+	std::vector<Cached> cache;
+	std::vector<Contact> reported;
+	Stats step_stats;
+
+	//islands, union-find parents and each island's range of solves
+	std::vector<int> parent;
+	std::vector<int> island_index;
+	std::vector<size_t> island_start;
+	std::vector<size_t> island_schedule;
+	std::vector<float> island_sleep;
+	JobSystem* jobs = nullptr;
+};
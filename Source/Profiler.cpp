@@ -0,0 +1,224 @@
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+#include "Profiler.h"
+
+Profiler::Scope::Scope(int section) noexcept
+	: Scope(Profiler::global(), section)
+{
+}
+
+Profiler::Scope::Scope(Profiler& profiler, int section) noexcept
+	: profiler(profiler), section(section), start(Clock::now())
+{
+}
+
+Profiler::Scope::~Scope()
+{
+	profiler.add(section, start, Clock::now());
+}
+
+Profiler& Profiler::global()
+{
+	static Profiler profiler;
+	return profiler;
+}
+
+Profiler::Profiler(size_t capacity)
+	: capacity(capacity ? capacity : 1), epoch(Clock::now()), frame_start(epoch)
+{
+	names.reserve(MAX_SECTIONS);
+	names.push_back("frame");
+	samples.assign(this->capacity * MAX_SECTIONS, 0.0);
+}
+
+int Profiler::section(const std::string& name)
+{
+	auto found = std::find(names.begin(), names.end(), name);
+	if (found != names.end())
+	{
+		return static_cast<int>(found - names.begin());
+	}
+
+	if (names.size() == MAX_SECTIONS)
+	{
+		return -1;
+	}
+
+	names.push_back(name);
+	return static_cast<int>(names.size()) - 1;
+}
+
+/**
+*   @brief   Closes the current frame.
+*   @details The frame's length is stored in the FRAME section and
+             every section's total is copied into the ring, replacing
+             the oldest frame once it is full.
+*   @return  void
+*/
+void Profiler::beginFrame()
+{
+	if (!enabled)
+	{
+		return;
+	}
+
+	const auto now = Clock::now();
+	if (frame_started)
+	{
+		add(FRAME, frame_start, now);
+		std::copy(current, current + MAX_SECTIONS, samples.begin() + head * MAX_SECTIONS);
+		head = (head + 1) % capacity;
+		count = std::min(count + 1, capacity);
+		frame_number++;
+	}
+
+	std::fill(current, current + MAX_SECTIONS, 0.0);
+	frame_start = now;
+	frame_started = true;
+}
+
+void Profiler::add(int section, Clock::time_point start, Clock::time_point end)
+{
+	if (!enabled || section < 0 || section >= MAX_SECTIONS)
+	{
+		return;
+	}
+
+	const double duration_us =
+		std::chrono::duration<double, std::micro>(end - start).count();
+	current[section] += duration_us / 1000.0;
+
+	if (tracing)
+	{
+		Event event{ section, elapsedMicroseconds(start), duration_us };
+		if (events.size() < capacity * MAX_SECTIONS)
+		{
+			events.push_back(event);
+		}
+		else
+		{
+			events[event_head] = event;
+			event_head = (event_head + 1) % events.size();
+		}
+	}
+}
+
+/**
+*   @brief   Summarises the recorded frames.
+*   @details The percentile is taken by sorting a copy of each
+             section's samples, so call this every so often rather
+             than every frame.
+*   @return  One summary per section.
+*/
+const std::vector<Profiler::Summary>& Profiler::summarise()
+{
+	summaries.resize(names.size());
+	for (size_t s = 0; s < names.size(); s++)
+	{
+		Summary& summary = summaries[s];
+		summary = Summary();
+		summary.name = &names[s];
+		if (!count)
+		{
+			continue;
+		}
+
+		sorted.clear();
+		double total = 0;
+		for (size_t f = 0; f < count; f++)
+		{
+			const double sample = samples[f * MAX_SECTIONS + s];
+			sorted.push_back(sample);
+			total += sample;
+		}
+
+		std::sort(sorted.begin(), sorted.end());
+		const size_t p99 = static_cast<size_t>(std::ceil(0.99 * count)) - 1;
+		summary.min_ms = sorted.front();
+		summary.avg_ms = total / count;
+		summary.p99_ms = sorted[p99];
+	}
+
+	return summaries;
+}
+
+void Profiler::setTracing(bool enabled)
+{
+	tracing = enabled;
+	if (!tracing)
+	{
+		events.clear();
+		event_head = 0;
+	}
+}
+
+bool Profiler::dumpCSV(const std::string& file_name) const
+{
+	std::ofstream file(file_name);
+	if (!file)
+	{
+		return false;
+	}
+
+	file << "frame";
+	for (const auto& name : names)
+	{
+		file << ',' << name << "_ms";
+	}
+	file << '\n';
+
+	//oldest frame first
+	const size_t oldest = count < capacity ? 0 : head;
+	for (size_t i = 0; i < count; i++)
+	{
+		const size_t slot = (oldest + i) % capacity;
+		file << frame_number - count + i;
+		for (size_t s = 0; s < names.size(); s++)
+		{
+			file << ',' << samples[slot * MAX_SECTIONS + s];
+		}
+		file << '\n';
+	}
+
+	return file.good();
+}
+
+/**
+*   @brief   Writes the traced scopes as Chrome trace events.
+*   @details Each scope becomes a complete ("X") event on a single
+             thread, so nested scopes show as a flame graph.
+*   @return  True if the file was written.
+*/
+bool Profiler::dumpTrace(const std::string& file_name) const
+{
+	std::ofstream file(file_name);
+	if (!file)
+	{
+		return false;
+	}
+
+	file << "{\"traceEvents\":[\n";
+	for (size_t i = 0; i < events.size(); i++)
+	{
+		const Event& event = events[(event_head + i) % events.size()];
+		file << (i ? ",\n" : "")
+			<< "{\"name\":\"" << names[event.section]
+			<< "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << event.start_us
+			<< ",\"dur\":" << event.duration_us << '}';
+	}
+	file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+	return file.good();
+}
+
+size_t Profiler::frames() const noexcept
+{
+	return count;
+}
+
+double Profiler::elapsedMicroseconds(Clock::time_point time) const
+{
+	return std::chrono::duration<double, std::micro>(time - epoch).count();
+}
@@ -0,0 +1,144 @@
+#pragma once
+#include <chrono>
+#include <string>
+#include <vector>
+
+/**
+*  Frame and section timing.
+*  Sections are named once and then timed with a Scope, which adds the
+*  time between its construction and destruction to the section's total
+*  for the frame. Totals for the last capacity frames are kept in a ring
+*  buffer, from which the min, average and 99th percentile of each
+*  section are summarised. With tracing enabled every scope is also
+*  recorded individually so the frames can be dumped as a Chrome trace
+*  (chrome://tracing or ui.perfetto.dev) as well as a CSV of totals.
+*/
+class Profiler
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	static const int MAX_SECTIONS = 32;
+	static const int FRAME = 0;        /**< The section timing whole frames. */
+
+	/**
+	*  Times a section until it falls out of scope.
+	*/
+	class Scope
+	{
+	public:
+		explicit Scope(int section) noexcept;
+		Scope(Profiler& profiler, int section) noexcept;
+		~Scope();
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+	private:
+		Profiler& profiler;
+		int section;
+		Clock::time_point start;
+	};
+
+	/**
+	*  A section's timings over the recorded frames.
+	*/
+	struct Summary
+	{
+		const std::string* name = nullptr;
+		double min_ms = 0;
+		double avg_ms = 0;
+		double p99_ms = 0;
+	};
+
+	/**
+	*  Returns the process wide profiler.
+	*/
+	static Profiler& global();
+
+	/**
+	*  Constructor.
+	*  @param [in] capacity The number of frames to keep.
+	*/
+	explicit Profiler(size_t capacity = 240);
+
+	/**
+	*  Finds or adds a section.
+	*  @param [in] name The section's name.
+	*  @return The section's id, or -1 if there are already MAX_SECTIONS.
+	*/
+	int section(const std::string& name);
+
+	/**
+	*  Ends the current frame and starts the next.
+	*  Section totals since the last call are stored as one frame.
+	*/
+	void beginFrame();
+
+	/**
+	*  Adds a timed interval to a section.
+	*  @param [in] section The section's id.
+	*  @param [in] start When the interval began.
+	*  @param [in] end When the interval ended.
+	*/
+	void add(int section, Clock::time_point start, Clock::time_point end);
+
+	/**
+	*  Summarises every section over the recorded frames.
+	*  @return One summary per section, in the order they were added.
+	*/
+	const std::vector<Summary>& summarise();
+
+	/**
+	*  Records individual scopes for dumpTrace.
+	*  Only the most recent capacity * MAX_SECTIONS scopes are kept.
+	*/
+	void setTracing(bool enabled);
+
+	/**
+	*  Writes the recorded frames' section totals.
+	*  One row per frame, one column per section, in milliseconds.
+	*  @return True if the file was written.
+	*/
+	bool dumpCSV(const std::string& file_name) const;
+
+	/**
+	*  Writes the traced scopes in the Chrome trace event format.
+	*  @return True if the file was written.
+	*/
+	bool dumpTrace(const std::string& file_name) const;
+
+	/**
+	*  Returns the number of frames recorded, at most capacity.
+	*/
+	size_t frames() const noexcept;
+
+	bool enabled = true; /**< When false, scopes and frames are ignored. */
+
+private:
+	struct Event
+	{
+		int section;
+		double start_us;
+		double duration_us;
+	};
+
+	double elapsedMicroseconds(Clock::time_point time) const;
+
+	std::vector<std::string> names;
+	std::vector<double> samples;
+	std::vector<double> sorted;
+	std::vector<Summary> summaries;
+	double current[MAX_SECTIONS]{};
+	size_t capacity = 0;
+	size_t head = 0;
+	size_t count = 0;
+	unsigned long long frame_number = 0;
+	Clock::time_point epoch;
+	Clock::time_point frame_start;
+	bool frame_started = false;
+
+	bool tracing = false;
+	std::vector<Event> events;
+	size_t event_head = 0;
+};
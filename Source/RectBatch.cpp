@@ -0,0 +1,357 @@
+#include <algorithm>
+#include <limits>
+#include "RectBatch.h"
+
+#if defined(__AVX512F__)
+#define RECT_BATCH_AVX512
+#include <immintrin.h>
+#if defined(__GNUC__) && !defined(__clang__)
+//gcc trips over the undefined vectors inside its own min and max intrinsics
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+#elif defined(__AVX2__)
+#define RECT_BATCH_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RECT_BATCH_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+	//storage is padded to this many rects
+	const size_t BLOCK = 16;
+
+	//stands in for 1 / 0 so a ray parallel to an axis stays finite
+	const float HUGE_INVERSE = 1e30f;
+
+	const float PADDING = std::numeric_limits<float>::quiet_NaN();
+
+	size_t bitCount(uint64_t bits) noexcept
+	{
+		size_t n = 0;
+		for (; bits; n++)
+		{
+			bits &= bits - 1;
+		}
+
+		return n;
+	}
+
+	float inverse(float d) noexcept
+	{
+		return d != 0 ? 1.0f / d : HUGE_INVERSE;
+	}
+
+	//SIMD builds test whole padded blocks, so the mask is written a block
+	//at a time at the block's bit offset
+	inline void writeBits(std::vector<uint64_t>& mask, size_t index, uint64_t bits) noexcept
+	{
+		mask[index >> 6] |= bits << (index & 63);
+	}
+}
+
+const char* RectBatch::kernel() noexcept
+{
+#if defined(RECT_BATCH_AVX512)
+	return "avx512";
+#elif defined(RECT_BATCH_AVX2)
+	return "avx2";
+#elif defined(RECT_BATCH_SSE2)
+	return "sse2";
+#else
+	return "scalar";
+#endif
+}
+
+int RectBatch::lanes() noexcept
+{
+#if defined(RECT_BATCH_AVX512)
+	return 16;
+#elif defined(RECT_BATCH_AVX2)
+	return 8;
+#elif defined(RECT_BATCH_SSE2)
+	return 4;
+#else
+	return 1;
+#endif
+}
+
+bool RectBatch::isSet(const std::vector<uint64_t>& mask, size_t index) noexcept
+{
+	return (index >> 6) < mask.size() && (mask[index >> 6] >> (index & 63)) & 1;
+}
+
+void RectBatch::clear()
+{
+	std::fill(xs.begin(), xs.begin() + count, PADDING);
+	std::fill(ys.begin(), ys.begin() + count, PADDING);
+	std::fill(lengths.begin(), lengths.begin() + count, PADDING);
+	std::fill(heights.begin(), heights.begin() + count, PADDING);
+	count = 0;
+}
+
+void RectBatch::reserve(size_t capacity)
+{
+	const size_t padded = (capacity + BLOCK - 1) / BLOCK * BLOCK;
+	xs.reserve(padded);
+	ys.reserve(padded);
+	lengths.reserve(padded);
+	heights.reserve(padded);
+}
+
+size_t RectBatch::add(const rect& bounds)
+{
+	if (count == xs.size())
+	{
+		grow();
+	}
+
+	set(count, bounds);
+	return count++;
+}
+
+void RectBatch::set(size_t index, const rect& bounds)
+{
+	xs[index] = bounds.x;
+	ys[index] = bounds.y;
+	lengths[index] = bounds.length;
+	heights[index] = bounds.height;
+}
+
+rect RectBatch::get(size_t index) const
+{
+	rect bounds;
+	bounds.x = xs[index];
+	bounds.y = ys[index];
+	bounds.length = lengths[index];
+	bounds.height = heights[index];
+	return bounds;
+}
+
+size_t RectBatch::size() const noexcept
+{
+	return count;
+}
+
+/**
+*   @brief   Finds the rects overlapping a box.
+*   @details Two rects overlap when each one's near edge is at or
+             before the other's far edge on both axes, which is what
+             rect::isInside's four range checks reduce to.
+*   @return  The number of rects overlapping.
+*/
+size_t RectBatch::overlaps(const rect& box, std::vector<uint64_t>& mask) const
+{
+#if defined(RECT_BATCH_AVX512) || defined(RECT_BATCH_AVX2) || defined(RECT_BATCH_SSE2)
+	resetMask(mask);
+	const float right = box.x + box.length;
+	const float bottom = box.y + box.height;
+	size_t hits = 0;
+
+#if defined(RECT_BATCH_AVX512)
+	const __m512 bx = _mm512_set1_ps(box.x);
+	const __m512 by = _mm512_set1_ps(box.y);
+	const __m512 br = _mm512_set1_ps(right);
+	const __m512 bb = _mm512_set1_ps(bottom);
+	for (size_t i = 0; i < count; i += 16)
+	{
+		const __m512 x = _mm512_loadu_ps(&xs[i]);
+		const __m512 y = _mm512_loadu_ps(&ys[i]);
+		__mmask16 m = _mm512_cmp_ps_mask(bx, _mm512_add_ps(x, _mm512_loadu_ps(&lengths[i])), _CMP_LE_OQ);
+		m &= _mm512_cmp_ps_mask(x, br, _CMP_LE_OQ);
+		m &= _mm512_cmp_ps_mask(by, _mm512_add_ps(y, _mm512_loadu_ps(&heights[i])), _CMP_LE_OQ);
+		m &= _mm512_cmp_ps_mask(y, bb, _CMP_LE_OQ);
+		writeBits(mask, i, m);
+		hits += bitCount(m);
+	}
+#elif defined(RECT_BATCH_AVX2)
+	const __m256 bx = _mm256_set1_ps(box.x);
+	const __m256 by = _mm256_set1_ps(box.y);
+	const __m256 br = _mm256_set1_ps(right);
+	const __m256 bb = _mm256_set1_ps(bottom);
+	for (size_t i = 0; i < count; i += 8)
+	{
+		const __m256 x = _mm256_loadu_ps(&xs[i]);
+		const __m256 y = _mm256_loadu_ps(&ys[i]);
+		__m256 m = _mm256_cmp_ps(bx, _mm256_add_ps(x, _mm256_loadu_ps(&lengths[i])), _CMP_LE_OQ);
+		m = _mm256_and_ps(m, _mm256_cmp_ps(x, br, _CMP_LE_OQ));
+		m = _mm256_and_ps(m, _mm256_cmp_ps(by, _mm256_add_ps(y, _mm256_loadu_ps(&heights[i])), _CMP_LE_OQ));
+		m = _mm256_and_ps(m, _mm256_cmp_ps(y, bb, _CMP_LE_OQ));
+		const uint64_t bits = static_cast<uint64_t>(_mm256_movemask_ps(m));
+		writeBits(mask, i, bits);
+		hits += bitCount(bits);
+	}
+#else
+	const __m128 bx = _mm_set1_ps(box.x);
+	const __m128 by = _mm_set1_ps(box.y);
+	const __m128 br = _mm_set1_ps(right);
+	const __m128 bb = _mm_set1_ps(bottom);
+	for (size_t i = 0; i < count; i += 4)
+	{
+		const __m128 x = _mm_loadu_ps(&xs[i]);
+		const __m128 y = _mm_loadu_ps(&ys[i]);
+		__m128 m = _mm_cmple_ps(bx, _mm_add_ps(x, _mm_loadu_ps(&lengths[i])));
+		m = _mm_and_ps(m, _mm_cmple_ps(x, br));
+		m = _mm_and_ps(m, _mm_cmple_ps(by, _mm_add_ps(y, _mm_loadu_ps(&heights[i]))));
+		m = _mm_and_ps(m, _mm_cmple_ps(y, bb));
+		const uint64_t bits = static_cast<uint64_t>(_mm_movemask_ps(m));
+		writeBits(mask, i, bits);
+		hits += bitCount(bits);
+	}
+#endif
+
+	return hits;
+#else
+	return overlapsScalar(box, mask);
+#endif
+}
+
+/**
+*   @brief   Finds the rects crossed by a line segment.
+*   @details A slab test: the segment is clipped against the x and y
+             extents of each rect in turn and crosses it if anything
+             is left of the range 0 to max_t.
+*   @return  The number of rects crossed.
+*/
+size_t RectBatch::raycast(float x, float y, float dx, float dy, float max_t, std::vector<uint64_t>& mask) const
+{
+#if defined(RECT_BATCH_AVX512) || defined(RECT_BATCH_AVX2) || defined(RECT_BATCH_SSE2)
+	resetMask(mask);
+	const float inverse_dx = inverse(dx);
+	const float inverse_dy = inverse(dy);
+	size_t hits = 0;
+
+#if defined(RECT_BATCH_AVX512)
+	const __m512 ox = _mm512_set1_ps(x);
+	const __m512 oy = _mm512_set1_ps(y);
+	const __m512 ix = _mm512_set1_ps(inverse_dx);
+	const __m512 iy = _mm512_set1_ps(inverse_dy);
+	const __m512 zero = _mm512_setzero_ps();
+	const __m512 limit = _mm512_set1_ps(max_t);
+	for (size_t i = 0; i < count; i += 16)
+	{
+		const __m512 near_x = _mm512_sub_ps(_mm512_loadu_ps(&xs[i]), ox);
+		const __m512 near_y = _mm512_sub_ps(_mm512_loadu_ps(&ys[i]), oy);
+		const __m512 tx1 = _mm512_mul_ps(near_x, ix);
+		const __m512 tx2 = _mm512_mul_ps(_mm512_add_ps(near_x, _mm512_loadu_ps(&lengths[i])), ix);
+		const __m512 ty1 = _mm512_mul_ps(near_y, iy);
+		const __m512 ty2 = _mm512_mul_ps(_mm512_add_ps(near_y, _mm512_loadu_ps(&heights[i])), iy);
+		const __m512 enter = _mm512_max_ps(_mm512_min_ps(tx1, tx2), _mm512_min_ps(ty1, ty2));
+		const __m512 exit = _mm512_min_ps(_mm512_max_ps(tx1, tx2), _mm512_max_ps(ty1, ty2));
+		__mmask16 m = _mm512_cmp_ps_mask(_mm512_max_ps(enter, zero), exit, _CMP_LE_OQ);
+		m &= _mm512_cmp_ps_mask(enter, limit, _CMP_LE_OQ);
+		writeBits(mask, i, m);
+		hits += bitCount(m);
+	}
+#elif defined(RECT_BATCH_AVX2)
+	const __m256 ox = _mm256_set1_ps(x);
+	const __m256 oy = _mm256_set1_ps(y);
+	const __m256 ix = _mm256_set1_ps(inverse_dx);
+	const __m256 iy = _mm256_set1_ps(inverse_dy);
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 limit = _mm256_set1_ps(max_t);
+	for (size_t i = 0; i < count; i += 8)
+	{
+		const __m256 near_x = _mm256_sub_ps(_mm256_loadu_ps(&xs[i]), ox);
+		const __m256 near_y = _mm256_sub_ps(_mm256_loadu_ps(&ys[i]), oy);
+		const __m256 tx1 = _mm256_mul_ps(near_x, ix);
+		const __m256 tx2 = _mm256_mul_ps(_mm256_add_ps(near_x, _mm256_loadu_ps(&lengths[i])), ix);
+		const __m256 ty1 = _mm256_mul_ps(near_y, iy);
+		const __m256 ty2 = _mm256_mul_ps(_mm256_add_ps(near_y, _mm256_loadu_ps(&heights[i])), iy);
+		const __m256 enter = _mm256_max_ps(_mm256_min_ps(tx1, tx2), _mm256_min_ps(ty1, ty2));
+		const __m256 exit = _mm256_min_ps(_mm256_max_ps(tx1, tx2), _mm256_max_ps(ty1, ty2));
+		__m256 m = _mm256_cmp_ps(_mm256_max_ps(enter, zero), exit, _CMP_LE_OQ);
+		m = _mm256_and_ps(m, _mm256_cmp_ps(enter, limit, _CMP_LE_OQ));
+		const uint64_t bits = static_cast<uint64_t>(_mm256_movemask_ps(m));
+		writeBits(mask, i, bits);
+		hits += bitCount(bits);
+	}
+#else
+	const __m128 ox = _mm_set1_ps(x);
+	const __m128 oy = _mm_set1_ps(y);
+	const __m128 ix = _mm_set1_ps(inverse_dx);
+	const __m128 iy = _mm_set1_ps(inverse_dy);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 limit = _mm_set1_ps(max_t);
+	for (size_t i = 0; i < count; i += 4)
+	{
+		const __m128 near_x = _mm_sub_ps(_mm_loadu_ps(&xs[i]), ox);
+		const __m128 near_y = _mm_sub_ps(_mm_loadu_ps(&ys[i]), oy);
+		const __m128 tx1 = _mm_mul_ps(near_x, ix);
+		const __m128 tx2 = _mm_mul_ps(_mm_add_ps(near_x, _mm_loadu_ps(&lengths[i])), ix);
+		const __m128 ty1 = _mm_mul_ps(near_y, iy);
+		const __m128 ty2 = _mm_mul_ps(_mm_add_ps(near_y, _mm_loadu_ps(&heights[i])), iy);
+		const __m128 enter = _mm_max_ps(_mm_min_ps(tx1, tx2), _mm_min_ps(ty1, ty2));
+		const __m128 exit = _mm_min_ps(_mm_max_ps(tx1, tx2), _mm_max_ps(ty1, ty2));
+		__m128 m = _mm_cmple_ps(_mm_max_ps(enter, zero), exit);
+		m = _mm_and_ps(m, _mm_cmple_ps(enter, limit));
+		const uint64_t bits = static_cast<uint64_t>(_mm_movemask_ps(m));
+		writeBits(mask, i, bits);
+		hits += bitCount(bits);
+	}
+#endif
+
+	return hits;
+#else
+	return raycastScalar(x, y, dx, dy, max_t, mask);
+#endif
+}
+
+size_t RectBatch::overlapsScalar(const rect& box, std::vector<uint64_t>& mask) const
+{
+	resetMask(mask);
+	const float right = box.x + box.length;
+	const float bottom = box.y + box.height;
+	size_t hits = 0;
+	for (size_t i = 0; i < count; i++)
+	{
+		if (box.x <= xs[i] + lengths[i] && xs[i] <= right &&
+			box.y <= ys[i] + heights[i] && ys[i] <= bottom)
+		{
+			writeBits(mask, i, 1);
+			hits++;
+		}
+	}
+
+	return hits;
+}
+
+size_t RectBatch::raycastScalar(float x, float y, float dx, float dy, float max_t, std::vector<uint64_t>& mask) const
+{
+	resetMask(mask);
+	const float inverse_dx = inverse(dx);
+	const float inverse_dy = inverse(dy);
+	size_t hits = 0;
+	for (size_t i = 0; i < count; i++)
+	{
+		const float near_x = xs[i] - x;
+		const float near_y = ys[i] - y;
+		const float tx1 = near_x * inverse_dx;
+		const float tx2 = (near_x + lengths[i]) * inverse_dx;
+		const float ty1 = near_y * inverse_dy;
+		const float ty2 = (near_y + heights[i]) * inverse_dy;
+		const float enter = std::max(std::min(tx1, tx2), std::min(ty1, ty2));
+		const float exit = std::min(std::max(tx1, tx2), std::max(ty1, ty2));
+		if (std::max(enter, 0.0f) <= exit && enter <= max_t)
+		{
+			writeBits(mask, i, 1);
+			hits++;
+		}
+	}
+
+	return hits;
+}
+
+void RectBatch::grow()
+{
+	xs.resize(xs.size() + BLOCK, PADDING);
+	ys.resize(ys.size() + BLOCK, PADDING);
+	lengths.resize(lengths.size() + BLOCK, PADDING);
+	heights.resize(heights.size() + BLOCK, PADDING);
+}
+
+void RectBatch::resetMask(std::vector<uint64_t>& mask) const
+{
+	mask.assign((count + 63) / 64, 0);
+}
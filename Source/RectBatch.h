@@ -0,0 +1,100 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Rect.h"
+
+/**
+*  A set of rects stored as structure of arrays.
+*  The x, y, length and height of every rect live in separate arrays so
+*  one box or ray can be tested against many rects at once, four, eight
+*  or sixteen at a time depending on whether the build targets SSE2,
+*  AVX2 or AVX-512, with a scalar fallback elsewhere. Results come back
+*  as a bitmask with bit i set when rect i is hit. Overlaps follow the
+*  same inclusive rules as rect::isInside, so the two can be swapped.
+*/
+class RectBatch
+{
+public:
+
+	/**
+	*  Returns the name of the kernel in use: "avx512", "avx2", "sse2"
+	*  or "scalar".
+	*/
+	static const char* kernel() noexcept;
+
+	/**
+	*  Returns how many rects the kernel tests at once.
+	*/
+	static int lanes() noexcept;
+
+	/**
+	*  Returns true if bit index is set in a mask.
+	*/
+	static bool isSet(const std::vector<uint64_t>& mask, size_t index) noexcept;
+
+	/**
+	*  Removes every rect. Storage is kept for reuse.
+	*/
+	void clear();
+
+	/**
+	*  Reserves storage for count rects.
+	*/
+	void reserve(size_t capacity);
+
+	/**
+	*  Adds a rect.
+	*  @return The rect's index, which is its bit in the masks.
+	*/
+	size_t add(const rect& bounds);
+
+	/**
+	*  Replaces the rect at an index.
+	*/
+	void set(size_t index, const rect& bounds);
+
+	/**
+	*  Returns the rect at an index.
+	*/
+	rect get(size_t index) const;
+
+	/**
+	*  Returns the number of rects.
+	*/
+	size_t size() const noexcept;
+
+	/**
+	*  Finds the rects overlapping a box.
+	*  @param [in] box The box to test.
+	*  @param [out] mask One bit per rect, 64 to a word.
+	*  @return The number of rects overlapping.
+	*/
+	size_t overlaps(const rect& box, std::vector<uint64_t>& mask) const;
+
+	/**
+	*  Finds the rects crossed by a line segment.
+	*  The segment runs from x, y to x + dx * max_t, y + dy * max_t.
+	*  A segment starting inside a rect crosses it.
+	*  @param [out] mask One bit per rect, 64 to a word.
+	*  @return The number of rects crossed.
+	*/
+	size_t raycast(float x, float y, float dx, float dy, float max_t, std::vector<uint64_t>& mask) const;
+
+	/**
+	*  The scalar versions of overlaps and raycast, for comparison.
+	*/
+	size_t overlapsScalar(const rect& box, std::vector<uint64_t>& mask) const;
+	size_t raycastScalar(float x, float y, float dx, float dy, float max_t, std::vector<uint64_t>& mask) const;
+
+private:
+	void grow();
+	void resetMask(std::vector<uint64_t>& mask) const;
+
+	//padded to a whole number of the widest vectors, unused lanes are
+	//NaN so they never compare as a hit
+	std::vector<float> xs;
+	std::vector<float> ys;
+	std::vector<float> lengths;
+	std::vector<float> heights;
+	size_t count = 0;
+};
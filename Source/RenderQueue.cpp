@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+
+#include <Engine/Renderer.h>
+#include <Engine/Sprite.h>
+#include "RenderQueue.h"
+#include "TextLabel.h"
+
+namespace
+{
+	//text is drawn using the font's texture, after the layer's sprites
+	const ASGE::Texture2D* const TEXT_TEXTURE =
+		reinterpret_cast<const ASGE::Texture2D*>(~static_cast<uintptr_t>(0));
+
+	//rocks overlap, but all share one texture, so sorting keeps their order;
+	//houses are stacked over the roofs below them and keep submission order
+	bool sortsByTexture(RenderLayer layer)
+	{
+		return layer == RenderLayer::ROCKS;
+	}
+}
+
+void RenderQueue::submit(const ASGE::Sprite& sprite, RenderLayer layer)
+{
+	Item item;
+	item.layer = layer;
+	item.texture = sprite.getTexture();
+	item.sprite = &sprite;
+	item.text = 0;
+	item.order = static_cast<unsigned int>(items.size());
+	items.push_back(item);
+}
+
+void RenderQueue::submitText(const std::string& text, int x, int y,
+	float scale, const ASGE::Colour& colour, RenderLayer layer)
+{
+	queueText(x, y, scale, colour, layer).text.assign(text);
+}
+
+void RenderQueue::submitText(const TextLabel& label, int x, int y,
+	float scale, const ASGE::Colour& colour, RenderLayer layer)
+{
+	queueText(x, y, scale, colour, layer).label = &label.text();
+}
+
+RenderQueue::Text& RenderQueue::queueText(int x, int y, float scale,
+	const ASGE::Colour& colour, RenderLayer layer)
+{
+	//reuse the strings from previous frames so their buffers are kept
+	if (text_count == texts.size())
+	{
+		texts.emplace_back();
+	}
+
+	Text& entry = texts[text_count];
+	entry.label = nullptr;
+	entry.x = x;
+	entry.y = y;
+	entry.scale = scale;
+	entry.colour = colour;
+
+	Item item;
+	item.layer = layer;
+	item.texture = TEXT_TEXTURE;
+	item.sprite = nullptr;
+	item.text = text_count++;
+	item.order = static_cast<unsigned int>(items.size());
+	items.push_back(item);
+	return entry;
+}
+
+/**
+*   @brief   Draws the queued frame.
+*   @details Items are ordered by layer, then by texture in the layers
+             where that cannot reorder overlapping sprites, then the
+             order they were submitted in, which keeps the result
+             stable between frames. The other layers keep their
+             submission order, but their text still follows their
+             sprites. Each run of a
+             single texture counts as one draw call. The layer is also
+             passed on as the z order.
+*   @return  void
+*/
+void RenderQueue::flush(ASGE::Renderer* renderer)
+{
+	std::sort(items.begin(), items.end(), [](const Item& lhs, const Item& rhs)
+	{
+		if (lhs.layer != rhs.layer)
+		{
+			return lhs.layer < rhs.layer;
+		}
+
+		if (sortsByTexture(lhs.layer))
+		{
+			if (lhs.texture != rhs.texture)
+			{
+				return std::less<const ASGE::Texture2D*>()(lhs.texture, rhs.texture);
+			}
+		}
+		else if ((lhs.texture == TEXT_TEXTURE) != (rhs.texture == TEXT_TEXTURE))
+		{
+			return rhs.texture == TEXT_TEXTURE;
+		}
+
+		return lhs.order < rhs.order;
+	});
+
+	frame_stats = Stats();
+	const ASGE::Texture2D* bound = nullptr;
+	for (const auto& item : items)
+	{
+		if (!frame_stats.draw_calls || item.texture != bound)
+		{
+			if (frame_stats.draw_calls)
+			{
+				frame_stats.texture_switches++;
+			}
+
+			frame_stats.draw_calls++;
+			bound = item.texture;
+		}
+
+		const float z_order = static_cast<float>(item.layer);
+		if (item.sprite)
+		{
+			renderer->renderSprite(*item.sprite, z_order);
+			frame_stats.sprites++;
+		}
+		else
+		{
+			const Text& text = texts[item.text];
+			renderer->renderText(text.label ? *text.label : text.text, text.x, text.y, text.scale, text.colour, z_order);
+			frame_stats.texts++;
+		}
+	}
+
+	items.clear();
+	text_count = 0;
+}
+
+const RenderQueue::Stats& RenderQueue::stats() const noexcept
+{
+	return frame_stats;
+}
@@ -0,0 +1,131 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <Engine/Colours.h>
+
+class TextLabel;
+
+namespace ASGE {
+	class Renderer;
+	class Sprite;
+	class Texture2D;
+}
+
+/**
+*  The layers the game draws in, back to front.
+*  Everything in a lower layer is drawn before anything in a higher one.
+*  Only ROCKS, whose sprites all share one texture, is reordered by
+*  texture; the other layers draw in the order they were submitted.
+*/
+enum class RenderLayer
+{
+	BACKGROUND = 0,
+	BUILDINGS,
+	ARMY,
+	ROCKS,
+	UI,         /**< Signs and panels. */
+	BUTTONS,    /**< Buttons drawn over the signs. */
+	CURSOR,
+	OVERLAY
+};
+
+/**
+*  Deferred, texture sorted sprite submission.
+*  Rather than drawing each sprite as soon as it is known about, the game
+*  submits its sprites and text here along with the layer they belong in.
+*  On flush the queue is sorted by layer and then, in layers where the
+*  order of overlapping sprites cannot change, by texture, so sprites
+*  that share a texture reach the renderer back to back and can be drawn
+*  as a single batch. Counters for the last flush are kept so the effect
+*  of batching can be measured.
+*/
+class RenderQueue
+{
+public:
+
+	/**
+	*  Counters describing the last flushed frame.
+	*/
+	struct Stats
+	{
+		unsigned int sprites = 0;          /**< Sprites submitted. */
+		unsigned int texts = 0;            /**< Text strings submitted. */
+		unsigned int draw_calls = 0;       /**< Batches, i.e. runs of a single texture. */
+		unsigned int texture_switches = 0; /**< Times the bound texture changed. */
+	};
+
+	/**
+	*  Queues a sprite.
+	*  The sprite is referenced, not copied, so it must remain valid
+	*  and unchanged until flush() is called.
+	*  @param [in] sprite The sprite to draw
+	*  @param [in] layer The layer to draw it in
+	*/
+	void submit(const ASGE::Sprite& sprite, RenderLayer layer);
+
+	/**
+	*  Queues a string of text.
+	*  The text is copied into storage reused between frames.
+	*  @param [in] text The text to render
+	*  @param [in] x The x position of the text
+	*  @param [in] y The y position of the text
+	*  @param [in] scale The scale to render the text at
+	*  @param [in] colour The colour of the text
+	*  @param [in] layer The layer to draw it in
+	*/
+	void submitText(const std::string& text, int x, int y, float scale,
+		const ASGE::Colour& colour, RenderLayer layer);
+
+	/**
+	*  Queues a label's text.
+	*  The label is referenced, not copied, so it must remain valid
+	*  and unchanged until flush() is called.
+	*  @param [in] label The label to render
+	*  @param [in] x The x position of the text
+	*  @param [in] y The y position of the text
+	*  @param [in] scale The scale to render the text at
+	*  @param [in] colour The colour of the text
+	*  @param [in] layer The layer to draw it in
+	*/
+	void submitText(const TextLabel& label, int x, int y, float scale,
+		const ASGE::Colour& colour, RenderLayer layer);
+
+	/**
+	*  Sorts and draws everything queued, then empties the queue.
+	*  @param [in] renderer The renderer to draw with
+	*/
+	void flush(ASGE::Renderer* renderer);
+
+	/**
+	*  Returns the counters for the last flush.
+	*  @return the statistics of the last frame
+	*/
+	const Stats& stats() const noexcept;
+
+private:
+	struct Item
+	{
+		RenderLayer layer;
+		const ASGE::Texture2D* texture;
+		const ASGE::Sprite* sprite;
+		size_t text;
+		unsigned int order;
+	};
+
+	struct Text
+	{
+		std::string text;
+		const std::string* label = nullptr;
+		int x = 0;
+		int y = 0;
+		float scale = 1.0f;
+		ASGE::Colour colour = ASGE::COLOURS::WHITE;
+	};
+
+	Text& queueText(int x, int y, float scale, const ASGE::Colour& colour, RenderLayer layer);
+
+	std::vector<Item> items;
+	std::vector<Text> texts;
+	size_t text_count = 0;
+	Stats frame_stats;
+};
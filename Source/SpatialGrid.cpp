@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <cmath>
+#include "SpatialGrid.h"
+
+SpatialGrid::SpatialGrid(float cell_size)
+	: cell_size(cell_size > 0 ? cell_size : 128.0f),
+	inverse_cell_size(1.0f / this->cell_size)
+{
+}
+
+void SpatialGrid::clear()
+{
+	//keep the cell lists so refilling the grid does not allocate
+	for (auto& cell : cells)
+	{
+		cell.second.clear();
+	}
+
+	std::fill(present.begin(), present.end(), 0);
+	object_count = 0;
+}
+
+void SpatialGrid::insert(int id, const rect& bounds)
+{
+	if (id < 0)
+	{
+		return;
+	}
+
+	remove(id);
+	if (static_cast<size_t>(id) >= present.size())
+	{
+		present.resize(id + 1, 0);
+		object_bounds.resize(id + 1);
+		stamps.resize(id + 1, 0);
+	}
+
+	const CellRange range = cellsOf(bounds);
+	for (int32_t y = range.y0; y <= range.y1; y++)
+	{
+		for (int32_t x = range.x0; x <= range.x1; x++)
+		{
+			cells[key(x, y)].push_back(id);
+		}
+	}
+
+	object_bounds[id] = bounds;
+	present[id] = 1;
+	object_count++;
+}
+
+void SpatialGrid::remove(int id)
+{
+	if (!contains(id))
+	{
+		return;
+	}
+
+	const CellRange range = cellsOf(object_bounds[id]);
+	for (int32_t y = range.y0; y <= range.y1; y++)
+	{
+		for (int32_t x = range.x0; x <= range.x1; x++)
+		{
+			auto found = cells.find(key(x, y));
+			if (found == cells.end())
+			{
+				continue;
+			}
+
+			auto& ids = found->second;
+			auto itr = std::find(ids.begin(), ids.end(), id);
+			if (itr != ids.end())
+			{
+				*itr = ids.back();
+				ids.pop_back();
+			}
+		}
+	}
+
+	present[id] = 0;
+	object_count--;
+}
+
+bool SpatialGrid::contains(int id) const noexcept
+{
+	return id >= 0 && static_cast<size_t>(id) < present.size() && present[id];
+}
+
+const rect& SpatialGrid::bounds(int id) const
+{
+	return object_bounds[id];
+}
+
+/**
+*   @brief   Finds the objects overlapping an area.
+*   @details Objects spanning several cells are seen once per cell, so
+             each is stamped the first time it is seen in a query. The
+             candidates are then narrowed down together.
+*   @return  void
+*/
+void SpatialGrid::query(const rect& area, std::vector<int>& hits) const
+{
+	hits.clear();
+	cells_visited = 0;
+	if (!object_count)
+	{
+		return;
+	}
+
+	if (++stamp == 0)
+	{
+		std::fill(stamps.begin(), stamps.end(), 0);
+		stamp = 1;
+	}
+
+	candidates.clear();
+	candidate_bounds.clear();
+	const CellRange range = cellsOf(area);
+	for (int32_t y = range.y0; y <= range.y1; y++)
+	{
+		for (int32_t x = range.x0; x <= range.x1; x++)
+		{
+			auto found = cells.find(key(x, y));
+			if (found == cells.end())
+			{
+				continue;
+			}
+
+			cells_visited++;
+			for (int id : found->second)
+			{
+				if (stamps[id] == stamp)
+				{
+					continue;
+				}
+
+				stamps[id] = stamp;
+				candidates.push_back(id);
+				candidate_bounds.add(object_bounds[id]);
+			}
+		}
+	}
+
+	candidate_bounds.overlaps(area, candidate_hits);
+	for (size_t i = 0; i < candidates.size(); i++)
+	{
+		if (RectBatch::isSet(candidate_hits, i))
+		{
+			hits.push_back(candidates[i]);
+		}
+	}
+
+	std::sort(hits.begin(), hits.end());
+}
+
+size_t SpatialGrid::size() const noexcept
+{
+	return object_count;
+}
+
+size_t SpatialGrid::lastCellsVisited() const noexcept
+{
+	return cells_visited;
+}
+
+SpatialGrid::CellRange SpatialGrid::cellsOf(const rect& bounds) const noexcept
+{
+	CellRange range;
+	range.x0 = static_cast<int32_t>(std::floor(bounds.x * inverse_cell_size));
+	range.y0 = static_cast<int32_t>(std::floor(bounds.y * inverse_cell_size));
+	range.x1 = static_cast<int32_t>(std::floor((bounds.x + bounds.length) * inverse_cell_size));
+	range.y1 = static_cast<int32_t>(std::floor((bounds.y + bounds.height) * inverse_cell_size));
+	return range;
+}
+
+uint64_t SpatialGrid::key(int32_t x, int32_t y) noexcept
+{
+	return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
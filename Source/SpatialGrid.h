@@ -0,0 +1,100 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "Rect.h"
+#include "RectBatch.h"
+
+/**
+*  Uniform grid broad phase.
+*  Space is split into square cells and each object is listed in every
+*  cell its bounds touch. Cells are hashed, so the grid is unbounded and
+*  only occupied cells use memory. Static objects are inserted once and
+*  removed when destroyed; moving objects query the cells under their
+*  bounds rather than testing every object, so the cost of a query
+*  depends on how crowded the area is, not on how many objects exist.
+*  Objects are identified by small, non-negative ids chosen by the
+*  caller.
+*/
+class SpatialGrid
+{
+public:
+
+	/**
+	*  Constructor.
+	*  @param [in] cell_size The width and height of a cell.
+	*/
+	explicit SpatialGrid(float cell_size = 128.0f);
+
+	/**
+	*  Removes every object.
+	*/
+	void clear();
+
+	/**
+	*  Adds an object, replacing it if the id is already present.
+	*  @param [in] id The object's id.
+	*  @param [in] bounds The object's bounding box.
+	*/
+	void insert(int id, const rect& bounds);
+
+	/**
+	*  Removes an object. Does nothing if it is not present.
+	*  @param [in] id The object's id.
+	*/
+	void remove(int id);
+
+	/**
+	*  Checks whether an object is present.
+	*/
+	bool contains(int id) const noexcept;
+
+	/**
+	*  Returns the bounds an object was inserted with.
+	*  The object must be present.
+	*/
+	const rect& bounds(int id) const;
+
+	/**
+	*  Finds the objects overlapping an area.
+	*  Candidates from the grid are checked against their bounds in one
+	*  RectBatch pass, so only real overlaps are returned, in ascending
+	*  id order.
+	*  @param [in] area The area to search.
+	*  @param [out] hits The ids found. Cleared first.
+	*/
+	void query(const rect& area, std::vector<int>& hits) const;
+
+	/**
+	*  Returns the number of objects present.
+	*/
+	size_t size() const noexcept;
+
+	/**
+	*  Returns the number of cell lists checked by the last query.
+	*/
+	size_t lastCellsVisited() const noexcept;
+
+private:
+	struct CellRange
+	{
+		int32_t x0, y0, x1, y1;
+	};
+
+	CellRange cellsOf(const rect& bounds) const noexcept;
+	static uint64_t key(int32_t x, int32_t y) noexcept;
+
+	float cell_size;
+	float inverse_cell_size;
+	std::unordered_map<uint64_t, std::vector<int>> cells;
+	std::vector<rect> object_bounds;
+	std::vector<uint8_t> present;
+	size_t object_count = 0;
+
+	mutable std::vector<uint32_t> stamps;
+	mutable uint32_t stamp = 0;
+	mutable size_t cells_visited = 0;
+	mutable std::vector<int> candidates;
+	mutable RectBatch candidate_bounds;
+	mutable std::vector<uint64_t> candidate_hits;
+};
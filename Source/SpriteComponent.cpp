@@ -1,5 +1,8 @@
-#include <Engine\Renderer.h>
+#include <Engine/Renderer.h>
 #include "SpriteComponent.h"
+#include "SpritePool.h"
+#include "TextureAtlas.h"
+#include "TextureCache.h"
 
 SpriteComponent::~SpriteComponent()
 {
@@ -9,24 +12,105 @@ SpriteComponent::~SpriteComponent()
 bool SpriteComponent::loadSprite(
 	ASGE::Renderer* renderer, const std::string& texture_file_name)
 {
-	freeSprite();
-	sprite = renderer->createRawSprite();
-	if (sprite->loadTexture(texture_file_name))
+	if (loadState(renderer, 0, texture_file_name))
 	{
+		setState(0);
 		return true;
 	}
 
-	freeSprite();
 	return false;
 }
 
+bool SpriteComponent::loadSprite(
+	ASGE::Renderer* renderer, const TextureAtlas& atlas, const std::string& name)
+{
+	const std::string& image = atlas.getImageFile(name);
+	if (image.empty() || !loadSprite(renderer, image))
+	{
+		return false;
+	}
+
+	return atlas.applyRegion(sprite, name);
+}
+
+bool SpriteComponent::loadState(
+	ASGE::Renderer* renderer, int state, const std::string& texture_file_name)
+{
+	if (state < 0 || state >= MAX_STATES)
+	{
+		return false;
+	}
+
+	auto& cache = TextureCache::global();
+	if (states[state] && state_files[state] == texture_file_name)
+	{
+		return cache.reuse(texture_file_name);
+	}
+
+	freeState(state);
+	states[state] = cache.acquire(renderer, texture_file_name);
+	if (!states[state])
+	{
+		return false;
+	}
+
+	state_files[state] = texture_file_name;
+	if (state == active_state)
+	{
+		sprite = states[state];
+	}
+
+	return true;
+}
+
+void SpriteComponent::setState(int state) noexcept
+{
+	if (state < 0 || state >= MAX_STATES || !states[state])
+	{
+		return;
+	}
+
+	ASGE::Sprite* next = states[state];
+	if (sprite && sprite != next)
+	{
+		next->xPos(sprite->xPos());
+		next->yPos(sprite->yPos());
+	}
+
+	sprite = next;
+	active_state = state;
+}
+
+int SpriteComponent::getState() const noexcept
+{
+	return active_state;
+}
+
+void SpriteComponent::freeState(int state)
+{
+	if (states[state])
+	{
+		TextureCache::global().release(state_files[state]);
+		if (sprite == states[state])
+		{
+			sprite = nullptr;
+		}
+
+		SpritePool::global().release(states[state]);
+		states[state] = nullptr;
+		state_files[state].clear();
+	}
+}
+
 void SpriteComponent::freeSprite()
 {
-	if (sprite)
+	for (int i = 0; i < MAX_STATES; i++)
 	{
-		delete sprite;
-		sprite = nullptr;
+		freeState(i);
 	}
+
+	sprite = nullptr;
+	active_state = 0;
 }
 
 
@@ -45,4 +129,4 @@ rect SpriteComponent::getBoundingBox() const
 	bounding_box.height = sprite->height();
 
 	return bounding_box;
-}
\ No newline at end of file
+}
@@ -1,18 +1,30 @@
 #pragma once
-#include <Engine\Sprite.h>
+#include <string>
+#include <Engine/Sprite.h>
 #include "Rect.h"
+
+class TextureAtlas;
+
 /**
 *  Sprite Components are used by GameObjects
 *  A component based approach allows GameObjects to decide
 *  on whether they want to have specific functionality. This
 *  is a better approach than using multiple inheritance to
 *  construct an object using classes as traits.
+*  A component can hold several states, for example an intact and a
+*  damaged variant of the same object. Every state is loaded up front
+*  and switching between them simply changes the active sprite.
 *  @see GameObject
 */
 class SpriteComponent
 {
 public:
 
+	/**
+	*  The number of sprite states a single component can hold.
+	*/
+	static const int MAX_STATES = 3;
+
 	/**
 	*  Default constructor.
 	*/
@@ -25,15 +37,55 @@ public:
 
 	/**
 	*  Allocates and loads the sprite.
-	*  Part of this process will attempt to load a texture file.
-	*  If this fails this function will return false and the memory
-	*  allocated, freed.
+	*  Loads the default state (0) and makes it the active one.
+	*  Textures are requested through the TextureCache, so a file is only
+	*  decoded the first time it is used. Asking for the texture this
+	*  component already holds keeps the existing sprite. If loading
+	*  fails this function will return false and the memory allocated, freed.
 	*  @param [in] renderer The renderer used to perform the allocations
 	*  @param [in] texture_file_name The file path to the the texture to load
 	*  @return true if the sprite was successfully loaded
 	*/
 	bool  loadSprite(ASGE::Renderer* renderer, const std::string& texture_file_name);
 
+	/**
+	*  Allocates a sprite that draws a region of a texture atlas.
+	*  The sprite is bound to the atlas' sheet and its source rectangle
+	*  set to the named sub texture. Sprites from the same atlas share
+	*  a single texture.
+	*  @param [in] renderer The renderer used to perform the allocations
+	*  @param [in] atlas The atlas containing the sub texture
+	*  @param [in] name The name of the sub texture
+	*  @return true if the sprite was successfully loaded
+	*/
+	bool  loadSprite(ASGE::Renderer* renderer, const TextureAtlas& atlas, const std::string& name);
+
+	/**
+	*  Allocates and loads the sprite used by a given state.
+	*  The active state is not changed. Call this at initialisation
+	*  time so that switching states later never touches the disk.
+	*  @param [in] renderer The renderer used to perform the allocations
+	*  @param [in] state The state index, less than MAX_STATES
+	*  @param [in] texture_file_name The file path to the the texture to load
+	*  @return true if the sprite was successfully loaded
+	*/
+	bool  loadState(ASGE::Renderer* renderer, int state, const std::string& texture_file_name);
+
+	/**
+	*  Switches the active sprite to a previously loaded state.
+	*  The new sprite takes over the position of the old one. No
+	*  allocations or loading take place. States that have not been
+	*  loaded are ignored.
+	*  @param [in] state The state index, less than MAX_STATES
+	*/
+	void  setState(int state) noexcept;
+
+	/**
+	*  Returns the index of the active state.
+	*  @return the active state
+	*/
+	int   getState() const noexcept;
+
 	/**
 	*  Returns a pointer to the sprite residing in this component.
 	*  As this is a pointer, you will need to check its contents before 
@@ -53,5 +105,9 @@ public:
 
 private:
 	void freeSprite();
+	void freeState(int state);
 	ASGE::Sprite* sprite = nullptr;
+	ASGE::Sprite* states[MAX_STATES] = {};
+	std::string state_files[MAX_STATES];
+	int active_state = 0;
 };
\ No newline at end of file
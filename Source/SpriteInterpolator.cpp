@@ -0,0 +1,84 @@
+#include <cmath>
+#include <Engine/Sprite.h>
+#include "SpriteInterpolator.h"
+
+void SpriteInterpolator::clear()
+{
+	restore();
+	entries.clear();
+}
+
+void SpriteInterpolator::track(ASGE::Sprite* sprite)
+{
+	if (!sprite)
+	{
+		return;
+	}
+
+	for (auto& entry : entries)
+	{
+		if (entry.sprite == sprite)
+		{
+			return;
+		}
+	}
+
+	Entry entry;
+	entry.sprite = sprite;
+	entry.previous[0] = sprite->xPos();
+	entry.previous[1] = sprite->yPos();
+	entries.push_back(entry);
+}
+
+void SpriteInterpolator::capture()
+{
+	for (auto& entry : entries)
+	{
+		entry.previous[0] = entry.sprite->xPos();
+		entry.previous[1] = entry.sprite->yPos();
+	}
+}
+
+/**
+*   @brief   Places the sprites where they are drawn.
+*   @details Blends each sprite from its captured to its simulated
+             position. The simulated position is kept so restore()
+             can put it back.
+*   @return  void
+*/
+void SpriteInterpolator::apply(float alpha)
+{
+	for (auto& entry : entries)
+	{
+		entry.current[0] = entry.sprite->xPos();
+		entry.current[1] = entry.sprite->yPos();
+
+		const float dx = entry.current[0] - entry.previous[0];
+		const float dy = entry.current[1] - entry.previous[1];
+		if (std::fabs(dx) > snap_distance || std::fabs(dy) > snap_distance)
+		{
+			continue;
+		}
+
+		entry.sprite->xPos(entry.previous[0] + dx * alpha);
+		entry.sprite->yPos(entry.previous[1] + dy * alpha);
+	}
+
+	applied = true;
+}
+
+void SpriteInterpolator::restore()
+{
+	if (!applied)
+	{
+		return;
+	}
+
+	for (auto& entry : entries)
+	{
+		entry.sprite->xPos(entry.current[0]);
+		entry.sprite->yPos(entry.current[1]);
+	}
+
+	applied = false;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <vector>
+
+namespace ASGE {
+	class Sprite;
+}
+
+/**
+*  Smooths the drawing of sprites moved by a fixed rate simulation.
+*  The simulation keeps its state in the sprites' positions. Before the
+*  last tick of a frame the positions are captured; when drawing, each
+*  tracked sprite is placed between the captured and the current
+*  position by the timestep's alpha, then put back once the frame has
+*  been flushed so the simulation never sees the blended values.
+*/
+class SpriteInterpolator
+{
+public:
+
+	/**
+	*  Removes every tracked sprite.
+	*/
+	void clear();
+
+	/**
+	*  Tracks a sprite, capturing its current position.
+	*  @param [in] sprite The sprite to interpolate.
+	*/
+	void track(ASGE::Sprite* sprite);
+
+	/**
+	*  Captures the position of every tracked sprite.
+	*  Call before running the frame's last tick.
+	*/
+	void capture();
+
+	/**
+	*  Moves the tracked sprites to their drawn positions.
+	*  Sprites that moved further than snap_distance in the last tick
+	*  were teleported and are drawn where they are.
+	*  @param [in] alpha The blend between the captured and current position.
+	*/
+	void apply(float alpha);
+
+	/**
+	*  Returns the tracked sprites to their simulated positions.
+	*/
+	void restore();
+
+	float snap_distance = 200.0f; /**< Movement per tick treated as a teleport. */
+
+private:
+	struct Entry
+	{
+		ASGE::Sprite* sprite = nullptr;
+		float previous[2]{ 0,0 };
+		float current[2]{ 0,0 };
+	};
+
+	std::vector<Entry> entries;
+	bool applied = false;
+};
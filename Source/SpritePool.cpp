@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <Engine/Colours.h>
+#include <Engine/Renderer.h>
+#include <Engine/Sprite.h>
+#include "SpritePool.h"
+
+SpritePool& SpritePool::global()
+{
+	static SpritePool pool;
+	return pool;
+}
+
+SpritePool::SpritePool(size_t capacity)
+{
+	counters.name = "sprites";
+	counters.capacity = capacity;
+	idle.reserve(capacity);
+}
+
+SpritePool::~SpritePool()
+{
+	for (ASGE::Sprite* sprite : idle)
+	{
+		delete sprite;
+	}
+}
+
+void SpritePool::reserve(ASGE::Renderer* renderer, size_t count)
+{
+	count = std::min(count, counters.capacity);
+	while (idle.size() < count)
+	{
+		idle.push_back(renderer->createRawSprite());
+	}
+}
+
+ASGE::Sprite* SpritePool::acquire(ASGE::Renderer* renderer)
+{
+	counters.allocations++;
+	counters.in_use++;
+	counters.high_water = std::max(counters.high_water, counters.in_use);
+
+	if (idle.empty())
+	{
+		counters.heap_fallbacks++;
+		return renderer->createRawSprite();
+	}
+
+	ASGE::Sprite* sprite = idle.back();
+	idle.pop_back();
+	return sprite;
+}
+
+/**
+*   @brief   Returns a sprite to the pool.
+*   @details The sprite is put back as createRawSprite made it, apart
+             from its texture and size, which the next loadTexture
+             replaces.
+*   @return  void
+*/
+void SpritePool::release(ASGE::Sprite* sprite)
+{
+	if (!sprite)
+	{
+		return;
+	}
+
+	if (counters.in_use)
+	{
+		counters.in_use--;
+	}
+
+	if (idle.size() == counters.capacity)
+	{
+		delete sprite;
+		return;
+	}
+
+	sprite->xPos(0);
+	sprite->yPos(0);
+	sprite->rotationInRadians(0);
+	sprite->scale(1);
+	sprite->colour(ASGE::COLOURS::WHITE);
+	sprite->setFlipFlags(ASGE::Sprite::NORMAL);
+	sprite->opacity(1);
+	idle.push_back(sprite);
+}
+
+const PoolStats& SpritePool::stats() const noexcept
+{
+	return counters;
+}
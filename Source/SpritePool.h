@@ -0,0 +1,75 @@
+#pragma once
+#include <vector>
+#include "ObjectPool.h"
+
+namespace ASGE {
+	class Renderer;
+	class Sprite;
+}
+
+/**
+*  Recycles the renderer's sprites.
+*  Sprites are made by Renderer::createRawSprite, whose concrete type
+*  belongs to the engine, so rather than constructing them in a slab
+*  the pool keeps released sprites on a free list, up to its capacity,
+*  and hands them out again. Reserving the capacity up front means a
+*  level can free and recreate its sprites without any allocations.
+*  @see TextureCache
+*/
+class SpritePool
+{
+public:
+
+	/**
+	*  Returns the process wide pool.
+	*  @return the pool shared by every sprite component
+	*/
+	static SpritePool& global();
+
+	/**
+	*  Constructor.
+	*  @param [in] capacity The most idle sprites to keep.
+	*/
+	explicit SpritePool(size_t capacity = 64);
+
+	/**
+	*  Destructor. Deletes the idle sprites.
+	*/
+	~SpritePool();
+
+	SpritePool(const SpritePool&) = delete;
+	SpritePool& operator=(const SpritePool&) = delete;
+
+	/**
+	*  Creates idle sprites until there are count of them.
+	*  @param [in] renderer The renderer used to allocate the sprites
+	*  @param [in] count The number of idle sprites wanted, at most capacity
+	*/
+	void reserve(ASGE::Renderer* renderer, size_t count);
+
+	/**
+	*  Returns an idle sprite, or a new one if there are none.
+	*  The sprite has no texture; load one before drawing it.
+	*  @param [in] renderer The renderer used if a sprite must be allocated
+	*  @return the sprite
+	*/
+	ASGE::Sprite* acquire(ASGE::Renderer* renderer);
+
+	/**
+	*  Returns a sprite to the pool.
+	*  Its position, rotation, scale, colour, flip and opacity are reset.
+	*  Sprites beyond the capacity are deleted.
+	*  @param [in] sprite The sprite, which may be null
+	*/
+	void release(ASGE::Sprite* sprite);
+
+	/**
+	*  Returns the pool's counters.
+	*  heap_fallbacks counts the sprites the renderer had to allocate.
+	*/
+	const PoolStats& stats() const noexcept;
+
+private:
+	std::vector<ASGE::Sprite*> idle;
+	PoolStats counters;
+};
@@ -0,0 +1,88 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+/**
+*  A fixed capacity, lock-free queue for one producer and one consumer.
+*  The producer only writes the tail and the consumer only writes the
+*  head, each on its own cache line, so neither side ever waits for the
+*  other: push fails when the queue is full and pop when it is empty.
+*  Each side keeps a copy of the other's index and only reloads it when
+*  the copy says the queue is full or empty, so most calls touch no
+*  shared line but their own. Values are copied in and out of a ring
+*  stored inline, nothing is allocated.
+*/
+template <typename T, size_t Capacity>
+class SpscQueue
+{
+public:
+	static_assert(Capacity && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+	static constexpr size_t CACHE_LINE = 64;
+
+	/**
+	*  Copies a value in. Only call from the producer's thread.
+	*  @return false if the queue was full
+	*/
+	bool push(const T& value) noexcept
+	{
+		const size_t tail = write_index.load(std::memory_order_relaxed);
+		if (tail - read_copy == Capacity)
+		{
+			read_copy = read_index.load(std::memory_order_acquire);
+			if (tail - read_copy == Capacity)
+			{
+				return false;
+			}
+		}
+
+		slots[tail & (Capacity - 1)] = value;
+		write_index.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	*  Copies the oldest value out. Only call from the consumer's thread.
+	*  @return false if the queue was empty
+	*/
+	bool pop(T& value) noexcept
+	{
+		const size_t head = read_index.load(std::memory_order_relaxed);
+		if (head == write_copy)
+		{
+			write_copy = write_index.load(std::memory_order_acquire);
+			if (head == write_copy)
+			{
+				return false;
+			}
+		}
+
+		value = slots[head & (Capacity - 1)];
+		read_index.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	*  Returns the number of values queued. Only exact when neither
+	*  side is running.
+	*/
+	size_t size() const noexcept
+	{
+		return write_index.load(std::memory_order_acquire) - read_index.load(std::memory_order_acquire);
+	}
+
+	static constexpr size_t capacity() noexcept
+	{
+		return Capacity;
+	}
+
+private:
+	//the producer's line
+	alignas(CACHE_LINE) std::atomic<size_t> write_index{ 0 };
+	size_t read_copy = 0;
+
+	//the consumer's line
+	alignas(CACHE_LINE) std::atomic<size_t> read_index{ 0 };
+	size_t write_copy = 0;
+
+	alignas(CACHE_LINE) T slots[Capacity];
+};
@@ -0,0 +1,212 @@
+#pragma once
+#include <vector>
+
+#include "Profiler.h"
+
+/**
+*  A finite state machine driven by its owner's member functions.
+*  Each state has optional enter, exit, update and render hooks. A
+*  change is only requested when asked for, and is applied at the start
+*  of the next update, so a state's update always finishes before its
+*  exit hook runs and setup work in the enter hooks runs exactly once
+*  per transition rather than once per frame. Each transition's exit
+*  and enter hooks are timed, and can be added to a profiler section so
+*  they show up in its trace.
+*/
+template <typename Owner>
+class StateMachine
+{
+public:
+	using Hook = void (Owner::*)();
+	using UpdateHook = void (Owner::*)(double dt_sec);
+
+	/**
+	*  A state's name and hooks. Any hook may be left null.
+	*/
+	struct State
+	{
+		const char* name = "";
+		Hook enter = nullptr;
+		Hook exit = nullptr;
+		UpdateHook update = nullptr;
+		Hook render = nullptr;
+	};
+
+	/**
+	*  The timing of a change of state.
+	*/
+	struct Transition
+	{
+		int from = -1;          /**< The state left, or -1 when started. */
+		int to = -1;            /**< The state entered. */
+		double hooks_ms = 0;    /**< Time spent in the exit and enter hooks. */
+		double stayed_ms = 0;   /**< Time spent in the state left. */
+	};
+
+	static const int NONE = -1;
+
+	/**
+	*  Constructor.
+	*  @param [in] owner The object whose members are the hooks.
+	*/
+	explicit StateMachine(Owner& owner) noexcept
+		: owner(owner)
+	{
+	}
+
+	/**
+	*  Adds or replaces a state.
+	*  @param [in] id The state's id, a small non negative number.
+	*  @param [in] hooks The state's name and hooks.
+	*/
+	void add(int id, const State& hooks)
+	{
+		if (id >= static_cast<int>(states.size()))
+		{
+			states.resize(id + 1);
+		}
+
+		states[id] = hooks;
+	}
+
+	/**
+	*  Adds the time spent in each transition's hooks to a section.
+	*/
+	void trace(Profiler& transition_profiler, int section) noexcept
+	{
+		profiler = &transition_profiler;
+		profile_section = section;
+	}
+
+	/**
+	*  Enters the first state straight away.
+	*/
+	void start(int id)
+	{
+		pending = id;
+		apply();
+	}
+
+	/**
+	*  Requests a change of state, applied by the next update.
+	*  A later request before then replaces an earlier one, and
+	*  requesting the current state cancels it.
+	*/
+	void change(int id) noexcept
+	{
+		pending = id == state ? NONE : id;
+	}
+
+	/**
+	*  Applies any requested change, then updates the current state.
+	*/
+	void update(double dt_sec)
+	{
+		apply();
+		if (state != NONE && states[state].update)
+		{
+			(owner.*states[state].update)(dt_sec);
+		}
+	}
+
+	/**
+	*  Renders the current state.
+	*/
+	void render()
+	{
+		if (state != NONE && states[state].render)
+		{
+			(owner.*states[state].render)();
+		}
+	}
+
+	/**
+	*  Returns the current state's id, or NONE before start.
+	*/
+	int current() const noexcept
+	{
+		return state;
+	}
+
+	/**
+	*  Returns true if a change has been requested and not yet applied.
+	*/
+	bool changing() const noexcept
+	{
+		return pending != NONE;
+	}
+
+	/**
+	*  Returns a state's name, or an empty string for unknown ids.
+	*/
+	const char* name(int id) const noexcept
+	{
+		return id >= 0 && id < static_cast<int>(states.size()) ? states[id].name : "";
+	}
+
+	/**
+	*  Returns the most recent transition.
+	*/
+	const Transition& lastTransition() const noexcept
+	{
+		return last;
+	}
+
+	/**
+	*  Returns the number of transitions since the machine started.
+	*/
+	unsigned int transitions() const noexcept
+	{
+		return count;
+	}
+
+private:
+	void apply()
+	{
+		if (pending == NONE)
+		{
+			return;
+		}
+
+		const int next = pending;
+		pending = NONE;
+
+		const Profiler::Clock::time_point start = Profiler::Clock::now();
+		if (state != NONE && states[state].exit)
+		{
+			(owner.*states[state].exit)();
+		}
+
+		last.from = state;
+		last.to = next;
+		last.stayed_ms = state == NONE ? 0 : milliseconds(entered, start);
+		state = next;
+		if (states[state].enter)
+		{
+			(owner.*states[state].enter)();
+		}
+
+		entered = Profiler::Clock::now();
+		last.hooks_ms = milliseconds(start, entered);
+		count++;
+		if (profiler)
+		{
+			profiler->add(profile_section, start, entered);
+		}
+	}
+
+	static double milliseconds(Profiler::Clock::time_point from, Profiler::Clock::time_point to) noexcept
+	{
+		return std::chrono::duration<double, std::milli>(to - from).count();
+	}
+
+	Owner& owner;
+	std::vector<State> states;
+	int state = NONE;
+	int pending = NONE;
+	Profiler::Clock::time_point entered;
+	Transition last;
+	unsigned int count = 0;
+	Profiler* profiler = nullptr;
+	int profile_section = -1;
+};
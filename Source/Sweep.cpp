@@ -0,0 +1,60 @@
+#include <algorithm>
+#include <cmath>
+#include "Sweep.h"
+
+namespace
+{
+	/**
+	*   @brief   Clips the motion's time range against one axis.
+	*   @details near and far are the grown target's edges relative
+	             to the box. A box not moving on this axis is either
+	             inside the slab for the whole motion or never.
+	*   @return  False if the range becomes empty.
+	*/
+	bool clip(float near, float far, float d, float& enter, float& leave) noexcept
+	{
+		if (d == 0)
+		{
+			return near <= 0 && far >= 0;
+		}
+
+		float t1 = near / d;
+		float t2 = far / d;
+		if (t1 > t2)
+		{
+			std::swap(t1, t2);
+		}
+
+		enter = std::max(enter, t1);
+		leave = std::min(leave, t2);
+		return enter <= leave;
+	}
+}
+
+rect Sweep::bounds(const rect& box, float dx, float dy) noexcept
+{
+	rect area = box;
+	area.x = std::min(box.x, box.x + dx);
+	area.y = std::min(box.y, box.y + dy);
+	area.length = box.length + std::abs(dx);
+	area.height = box.height + std::abs(dy);
+	return area;
+}
+
+bool Sweep::timeOfImpact(const rect& box, float dx, float dy, const rect& target, float& toi) noexcept
+{
+	float enter = 0.0f;
+	float leave = 1.0f;
+
+	//the target grown by the box's size, relative to the box
+	const float near_x = target.x - box.length - box.x;
+	const float near_y = target.y - box.height - box.y;
+	if (!clip(near_x, near_x + target.length + box.length, dx, enter, leave) ||
+		!clip(near_y, near_y + target.height + box.height, dy, enter, leave))
+	{
+		return false;
+	}
+
+	toi = enter;
+	return true;
+}
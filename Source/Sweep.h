@@ -0,0 +1,32 @@
+#pragma once
+#include "Rect.h"
+
+/**
+*  Swept box tests for fast moving objects.
+*  Testing where a projectile ends up each step misses anything thinner
+*  than the distance it moved, so instead its box is swept along the
+*  step's motion and the time of the first contact is found. A box
+*  moving by dx, dy against a target is the same as a point moving
+*  against the target grown by the box's size, which is a slab test.
+*  Times run from 0 at the start of the motion to 1 at the end.
+*/
+namespace Sweep
+{
+	/**
+	*  Returns the area covered by a box over its whole motion.
+	*  Used to query the broad phase before testing the candidates.
+	*/
+	rect bounds(const rect& box, float dx, float dy) noexcept;
+
+	/**
+	*  Finds when a moving box first touches a still one.
+	*  Touching edges count, as they do for rect::isInside, and boxes
+	*  that already overlap touch at time 0.
+	*  @param [in] box The moving box at the start of its motion.
+	*  @param [in] dx, dy The motion.
+	*  @param [in] target The still box.
+	*  @param [out] toi The time of impact, from 0 to 1.
+	*  @return True if they touch during the motion.
+	*/
+	bool timeOfImpact(const rect& box, float dx, float dy, const rect& target, float& toi) noexcept;
+}
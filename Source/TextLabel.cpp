@@ -0,0 +1,51 @@
+#include <charconv>
+#include <cstring>
+#include "TextLabel.h"
+
+namespace
+{
+	//the most characters an int formats to, sign included
+	const size_t MAX_DIGITS = 11;
+}
+
+TextLabel::TextLabel(const char* prefix, const char* suffix)
+	: line(prefix), suffix(suffix), prefix_length(std::strlen(prefix))
+{
+	line.reserve(prefix_length + MAX_DIGITS + this->suffix.size());
+}
+
+/**
+*   @brief   Formats the number into the label.
+*   @details The digits are written into a buffer on the stack and
+             copied over the old ones, which fits in the space
+             reserved by the constructor.
+*   @return  True if the text changed.
+*/
+bool TextLabel::set(int new_value) noexcept
+{
+	if (formatted && new_value == value)
+	{
+		return false;
+	}
+
+	char digits[MAX_DIGITS];
+	const auto result = std::to_chars(digits, digits + sizeof(digits), new_value);
+	line.resize(prefix_length);
+	line.append(digits, result.ptr);
+	line.append(suffix);
+
+	value = new_value;
+	formatted = true;
+	format_count++;
+	return true;
+}
+
+const std::string& TextLabel::text() const noexcept
+{
+	return line;
+}
+
+unsigned int TextLabel::formats() const noexcept
+{
+	return format_count;
+}
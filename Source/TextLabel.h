@@ -0,0 +1,47 @@
+#pragma once
+#include <string>
+
+/**
+*  A line of HUD text showing a number between a fixed prefix and suffix.
+*  The text is only formatted again when the number changes, into a
+*  string whose buffer is sized for any int when the label is made, so
+*  setting a label to the value it already shows costs a comparison and
+*  setting a new one never allocates.
+*/
+class TextLabel
+{
+public:
+
+	/**
+	*  Constructor.
+	*  @param [in] prefix The text before the number.
+	*  @param [in] suffix The text after the number.
+	*/
+	explicit TextLabel(const char* prefix, const char* suffix = "");
+
+	/**
+	*  Shows a number.
+	*  @param [in] value The number to show.
+	*  @return true if the text changed.
+	*/
+	bool set(int value) noexcept;
+
+	/**
+	*  Returns the label's text. The reference stays valid for the
+	*  label's lifetime, but its contents change with set.
+	*/
+	const std::string& text() const noexcept;
+
+	/**
+	*  Returns the number of times the text has been formatted.
+	*/
+	unsigned int formats() const noexcept;
+
+private:
+	std::string line;
+	std::string suffix;
+	size_t prefix_length = 0;
+	int value = 0;
+	bool formatted = false;
+	unsigned int format_count = 0;
+};
@@ -0,0 +1,361 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include <Engine/Renderer.h>
+#include <Engine/Sprite.h>
+#include "AtlasIndex.h"
+#include "MappedFile.h"
+#include "SpritePool.h"
+#include "TextureAtlas.h"
+#include "TextureBatch.h"
+#include "TextureCache.h"
+
+namespace
+{
+	/**
+	*   @brief   Removes a file extension from a sub texture's name.
+	*   @return  The name without its extension.
+	*/
+	std::string stripExtension(const std::string& name)
+	{
+		auto dot = name.find_last_of('.');
+		if (dot == std::string::npos || dot == 0)
+		{
+			return name;
+		}
+
+		return name.substr(0, dot);
+	}
+
+	/**
+	*   @brief   Reads an attribute from an xml tag.
+	*   @details Expects the attribute in the form name="value".
+	*   @return  True if the attribute was found.
+	*/
+	bool readAttribute(
+		const std::string& tag, const char* attribute, std::string& value)
+	{
+		std::string key = std::string(" ") + attribute + "=\"";
+		auto start = tag.find(key);
+		if (start == std::string::npos)
+		{
+			return false;
+		}
+
+		start += key.size();
+		auto end = tag.find('"', start);
+		if (end == std::string::npos)
+		{
+			return false;
+		}
+
+		value = tag.substr(start, end - start);
+		return true;
+	}
+
+	bool fileExists(const std::string& file_name)
+	{
+		std::ifstream file(hostPath(file_name), std::ios::binary);
+		return file.good();
+	}
+
+	std::string directoryOf(const std::string& file_name)
+	{
+		auto separator = file_name.find_last_of("/\\");
+		return separator == std::string::npos ?
+			"" : file_name.substr(0, separator + 1);
+	}
+}
+
+/**
+*   @brief   Destructor.
+*   @details Releases the atlas' references to its sheets and removes
+             any mounts that redirect to it.
+*/
+TextureAtlas::~TextureAtlas()
+{
+	TextureCache::global().unmount(this);
+	clear();
+}
+
+/**
+*   @brief   Loads an atlas.
+*   @details Parses the xml file, building the name to region index,
+             then loads the sheet via the texture cache. The sheet is
+             held for as long as the atlas exists.
+*   @return  True if successful.
+*/
+bool TextureAtlas::load(
+	ASGE::Renderer* renderer, const std::string& xml_file_name)
+{
+	std::ifstream file(hostPath(xml_file_name), std::ios::binary);
+	if (!file)
+	{
+		return false;
+	}
+
+	std::stringstream xml;
+	xml << file.rdbuf();
+
+	clear();
+	std::string image_path;
+	if (!parse(xml.str(), image_path))
+	{
+		return false;
+	}
+
+	//sheets are relative to the xml file
+	std::string image = directoryOf(xml_file_name) + image_path;
+	if (image_path.empty() || !fileExists(image))
+	{
+		image = stripExtension(xml_file_name) + ".png";
+	}
+
+	return loadSheet(renderer, image);
+}
+
+/**
+*   @brief   Loads a packed atlas index.
+*   @details The whole file is read with a single read and validated
+             against the counts in its header before any page is
+             loaded. Pages are relative to the index file.
+*   @return  True if successful.
+*/
+bool TextureAtlas::loadIndex(
+	ASGE::Renderer* renderer, const std::string& index_file_name)
+{
+	std::ifstream file(hostPath(index_file_name), std::ios::binary | std::ios::ate);
+	if (!file)
+	{
+		return false;
+	}
+
+	std::vector<char> data(static_cast<size_t>(file.tellg()));
+	file.seekg(0);
+	if (!file.read(data.data(), data.size()) ||
+		data.size() < sizeof(AtlasIndex::Header))
+	{
+		return false;
+	}
+
+	AtlasIndex::Header header;
+	std::memcpy(&header, data.data(), sizeof(header));
+	if (std::memcmp(header.magic, AtlasIndex::MAGIC, sizeof(header.magic)) ||
+		header.version != AtlasIndex::VERSION)
+	{
+		return false;
+	}
+
+	const size_t pages_offset = sizeof(AtlasIndex::Header);
+	const size_t entries_offset = pages_offset +
+		header.page_count * sizeof(AtlasIndex::Page);
+	const size_t strings_offset = entries_offset +
+		header.entry_count * sizeof(AtlasIndex::Entry);
+	if (strings_offset + header.string_bytes != data.size() ||
+		!header.string_bytes || data.back() != '\0')
+	{
+		return false;
+	}
+
+	const char* strings = data.data() + strings_offset;
+	clear();
+
+	//decode the pages together, loading the sheets is then a cache hit
+	std::string directory = directoryOf(index_file_name);
+	std::vector<std::string> pages;
+	TextureBatch batch;
+	for (uint16_t i = 0; i < header.page_count; i++)
+	{
+		AtlasIndex::Page page;
+		std::memcpy(&page, data.data() + pages_offset + i * sizeof(page), sizeof(page));
+		if (page.file_name >= header.string_bytes)
+		{
+			clear();
+			return false;
+		}
+
+		pages.push_back(directory + (strings + page.file_name));
+		batch.add(pages.back());
+	}
+
+	batch.load(renderer);
+	for (const auto& page : pages)
+	{
+		if (!loadSheet(renderer, page))
+		{
+			clear();
+			return false;
+		}
+	}
+
+	for (uint32_t i = 0; i < header.entry_count; i++)
+	{
+		AtlasIndex::Entry entry;
+		std::memcpy(&entry, data.data() + entries_offset + i * sizeof(entry), sizeof(entry));
+		if (entry.name >= header.string_bytes || entry.page >= header.page_count)
+		{
+			clear();
+			return false;
+		}
+
+		rect region;
+		region.x = entry.x;
+		region.y = entry.y;
+		region.length = entry.width;
+		region.height = entry.height;
+		addRegion(strings + entry.name, region, entry.page);
+	}
+
+	return true;
+}
+
+bool TextureAtlas::loadSheet(ASGE::Renderer* renderer, const std::string& image)
+{
+	ASGE::Sprite* sheet = TextureCache::global().acquire(renderer, image);
+	if (!sheet)
+	{
+		return false;
+	}
+
+	sheets.push_back(sheet);
+	image_files.push_back(image);
+	return true;
+}
+
+/**
+*   @brief   Parses the atlas xml.
+*   @details Reads the TextureAtlas imagePath and every SubTexture's
+             name and rectangle.
+*   @return  True if at least one sub texture was found.
+*/
+bool TextureAtlas::parse(const std::string& xml, std::string& image_path)
+{
+	auto atlas = xml.find("<TextureAtlas");
+	if (atlas != std::string::npos)
+	{
+		auto end = xml.find('>', atlas);
+		readAttribute(xml.substr(atlas, end - atlas), "imagePath", image_path);
+	}
+
+	std::string name, x, y, width, height;
+	size_t position = 0;
+	while ((position = xml.find("<SubTexture", position)) != std::string::npos)
+	{
+		auto end = xml.find('>', position);
+		if (end == std::string::npos)
+		{
+			break;
+		}
+
+		std::string tag = xml.substr(position, end - position);
+		position = end;
+
+		if (readAttribute(tag, "name", name) &&
+			readAttribute(tag, "x", x) &&
+			readAttribute(tag, "y", y) &&
+			readAttribute(tag, "width", width) &&
+			readAttribute(tag, "height", height))
+		{
+			rect region;
+			region.x = static_cast<float>(std::atof(x.c_str()));
+			region.y = static_cast<float>(std::atof(y.c_str()));
+			region.length = static_cast<float>(std::atof(width.c_str()));
+			region.height = static_cast<float>(std::atof(height.c_str()));
+			addRegion(name, region);
+		}
+	}
+
+	return !regions.empty();
+}
+
+void TextureAtlas::addRegion(const std::string& name, const rect& region, int page)
+{
+	std::string key = stripExtension(name);
+	auto found = lookup.find(key);
+	if (found != lookup.end())
+	{
+		regions[found->second] = region;
+		region_pages[found->second] = page;
+		return;
+	}
+
+	lookup.emplace(key, regions.size());
+	regions.push_back(region);
+	region_pages.push_back(page);
+}
+
+const rect* TextureAtlas::find(const std::string& name) const
+{
+	auto found = lookup.find(name);
+	if (found == lookup.end())
+	{
+		found = lookup.find(stripExtension(name));
+		if (found == lookup.end())
+		{
+			return nullptr;
+		}
+	}
+
+	return &regions[found->second];
+}
+
+/**
+*   @brief   Points a sprite at a region of the sheet.
+*   @details The source rectangle selects the texels to draw and the
+             sprite is resized so it is drawn at the region's size.
+*   @return  True if the region exists.
+*/
+bool TextureAtlas::applyRegion(
+	ASGE::Sprite* sprite, const std::string& name) const
+{
+	const rect* region = find(name);
+	if (!region || !sprite)
+	{
+		return false;
+	}
+
+	float* src = sprite->srcRect();
+	src[0] = region->x;
+	src[1] = region->y;
+	src[2] = region->length;
+	src[3] = region->height;
+	sprite->width(region->length);
+	sprite->height(region->height);
+	return true;
+}
+
+const std::string& TextureAtlas::getImageFile(const std::string& name) const
+{
+	static const std::string none;
+	const rect* region = find(name);
+	if (!region)
+	{
+		return none;
+	}
+
+	size_t page = region_pages[region - regions.data()];
+	return page < image_files.size() ? image_files[page] : none;
+}
+
+size_t TextureAtlas::size() const noexcept
+{
+	return regions.size();
+}
+
+void TextureAtlas::clear()
+{
+	for (size_t i = 0; i < sheets.size(); i++)
+	{
+		TextureCache::global().release(image_files[i]);
+		SpritePool::global().release(sheets[i]);
+	}
+
+	sheets.clear();
+	image_files.clear();
+	lookup.clear();
+	regions.clear();
+	region_pages.clear();
+}
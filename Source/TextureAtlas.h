@@ -0,0 +1,116 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Rect.h"
+
+namespace ASGE {
+	class Renderer;
+	class Sprite;
+}
+
+/**
+*  A sprite sheet described by a TextureAtlas xml file.
+*  The Kenney packs ship their sheets as a single image plus an xml
+*  file listing every SubTexture rectangle within it. The atlas parses
+*  the xml once, loads the sheet through the TextureCache and maps each
+*  sub texture's name to its rectangle. Sprites created from the atlas
+*  all share the sheet's texture and draw a region of it using their
+*  source rectangle, so they can be batched together by the renderer.
+*  Atlases baked by the AtlasPacker tool are loaded with loadIndex and
+*  may span several pages.
+*  @see TextureCache
+*  @see AtlasIndex
+*/
+class TextureAtlas
+{
+public:
+
+	/**
+	*  Default constructor.
+	*/
+	TextureAtlas() = default;
+
+	/**
+	*  Destructor. Releases the sheets' textures.
+	*/
+	~TextureAtlas();
+
+	/**
+	*  Parses an atlas xml file and loads its sheet.
+	*  The image is looked up relative to the xml file. Kenney's files
+	*  name a generic "sheet.png", so if that does not exist the image
+	*  with the same name as the xml file is used instead.
+	*  @param [in] renderer The renderer used to load the sheet
+	*  @param [in] xml_file_name The file path to the atlas xml
+	*  @return true if the xml was parsed and the sheet loaded
+	*/
+	bool load(ASGE::Renderer* renderer, const std::string& xml_file_name);
+
+	/**
+	*  Loads a binary atlas index written by the AtlasPacker tool.
+	*  The index is read in one go and every page it references is
+	*  loaded. Sub textures are named after the images they were
+	*  packed from, e.g. "army.png".
+	*  @param [in] renderer The renderer used to load the pages
+	*  @param [in] index_file_name The file path to the .atlas index
+	*  @return true if the index was valid and every page loaded
+	*/
+	bool loadIndex(ASGE::Renderer* renderer, const std::string& index_file_name);
+
+	/**
+	*  Finds a sub texture by name.
+	*  Names are stored without their file extension, so both
+	*  "elementWood000" and "elementWood000.png" resolve.
+	*  @param [in] name The sub texture's name
+	*  @return the region within the sheet or nullptr if not found
+	*/
+	const rect* find(const std::string& name) const;
+
+	/**
+	*  Points a sprite at one of the sheet's regions.
+	*  Sets the sprite's source rectangle and resizes it to match.
+	*  The sprite must already be bound to the sheet holding the region.
+	*  @param [in] sprite The sprite to update
+	*  @param [in] name The sub texture's name
+	*  @return true if the region exists
+	*/
+	bool applyRegion(ASGE::Sprite* sprite, const std::string& name) const;
+
+	/**
+	*  Returns the file path of the sheet holding a sub texture.
+	*  @param [in] name The sub texture's name
+	*  @return the sheet's path, as used by the TextureCache, or an
+	*          empty string if the sub texture does not exist
+	*/
+	const std::string& getImageFile(const std::string& name) const;
+
+	/**
+	*  Returns how many sub textures the atlas describes.
+	*  @return the number of regions
+	*/
+	size_t size() const noexcept;
+
+	/**
+	*  Adds a region to the atlas.
+	*  Used by the loaders, but also allows atlases to be built by hand.
+	*  @param [in] name The sub texture's name
+	*  @param [in] region The region within the sheet
+	*  @param [in] page The sheet holding the region
+	*/
+	void addRegion(const std::string& name, const rect& region, int page = 0);
+
+private:
+	TextureAtlas(const TextureAtlas&) = delete;
+	TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+	bool parse(const std::string& xml, std::string& image_path);
+	bool loadSheet(ASGE::Renderer* renderer, const std::string& image);
+	void clear();
+
+	std::unordered_map<std::string, size_t> lookup;
+	std::vector<rect> regions;
+	std::vector<int> region_pages;
+	std::vector<std::string> image_files;
+	std::vector<ASGE::Sprite*> sheets;
+};
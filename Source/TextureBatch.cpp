@@ -0,0 +1,74 @@
+#include <algorithm>
+#include <chrono>
+#include "JobSystem.h"
+#include "TextureBatch.h"
+#include "TextureCache.h"
+
+void TextureBatch::add(const std::string& texture_file_name)
+{
+	if (TextureCache::global().isResident(texture_file_name) ||
+		std::find(files.begin(), files.end(), texture_file_name) != files.end())
+	{
+		return;
+	}
+
+	files.push_back(texture_file_name);
+}
+
+/**
+*   @brief   Loads the batch.
+*   @details The files are decoded in parallel, each job writing only
+             its own pixel buffer and flag. The TextureCache and
+             renderer are not thread safe, so the pixels are then
+             uploaded one after another on the calling thread, and
+             their buffers freed. Files that could not be decoded are
+             loaded from their path instead. The pool is only started
+             when there is something to load.
+*   @return  True if every texture loaded.
+*/
+bool TextureBatch::load(ASGE::Renderer* renderer, unsigned int threads)
+{
+	using Clock = std::chrono::steady_clock;
+	last = Timing();
+	last.files = files.size();
+	if (files.empty())
+	{
+		return true;
+	}
+
+	const auto start = Clock::now();
+	decoded.resize(files.size());
+	ready.assign(files.size(), 0);
+	{
+		JobSystem jobs(threads);
+		last.threads = jobs.threads();
+		jobs.parallelFor(files.size(), [this](size_t i)
+		{
+			ready[i] = TextureCache::decode(files[i], decoded[i]);
+		});
+	}
+
+	const auto decode_end = Clock::now();
+	for (size_t i = 0; i < files.size(); i++)
+	{
+		const bool loaded = ready[i] ?
+			TextureCache::global().upload(renderer, decoded[i]) :
+			TextureCache::global().preload(renderer, files[i]);
+		if (!loaded)
+		{
+			last.failed++;
+		}
+	}
+
+	const auto upload_end = Clock::now();
+	last.decode_ms = std::chrono::duration<double, std::milli>(decode_end - start).count();
+	last.upload_ms = std::chrono::duration<double, std::milli>(upload_end - decode_end).count();
+	files.clear();
+	decoded.clear();
+	return last.failed == 0;
+}
+
+const TextureBatch::Timing& TextureBatch::timing() const noexcept
+{
+	return last;
+}
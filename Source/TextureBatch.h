@@ -0,0 +1,62 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "TexturePixels.h"
+
+namespace ASGE {
+	class Renderer;
+}
+
+/**
+*  Loads a set of textures at once.
+*  Every texture a screen needs is added up front, then load decodes
+*  them into memory across a JobSystem and uploads them to the
+*  TextureCache in one pass on the calling thread. Sprites created for
+*  them afterwards are cache hits. How long each pass took is kept for
+*  reporting. The real engine can only decode cooked images off the
+*  main thread, anything else it loads from its path while uploading.
+*  @see TextureCache::decode
+*/
+class TextureBatch
+{
+public:
+
+	/**
+	*  How the last load went.
+	*/
+	struct Timing
+	{
+		size_t files = 0;               /**< Files loaded, not counting those already resident. */
+		size_t failed = 0;              /**< Files that could not be loaded. */
+		unsigned int threads = 0;       /**< Threads the files were decoded on. */
+		double decode_ms = 0;           /**< Reading and decoding into memory. */
+		double upload_ms = 0;           /**< Making the textures resident. */
+	};
+
+	/**
+	*  Adds a texture to the batch.
+	*  Textures already resident or already added are skipped.
+	*  @param [in] texture_file_name The file path to the texture
+	*/
+	void add(const std::string& texture_file_name);
+
+	/**
+	*  Loads every texture added since the last load.
+	*  @param [in] renderer The renderer used to create the textures
+	*  @param [in] threads The threads to decode on, including the
+	*  caller. 0 uses one per hardware thread.
+	*  @return true if every texture loaded
+	*/
+	bool load(ASGE::Renderer* renderer, unsigned int threads = 0);
+
+	/**
+	*  Returns the timings of the last load.
+	*/
+	const Timing& timing() const noexcept;
+
+private:
+	std::vector<std::string> files;
+	std::vector<TexturePixels> decoded;
+	std::vector<unsigned char> ready;
+	Timing last;
+};
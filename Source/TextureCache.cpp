@@ -0,0 +1,368 @@
+#include <Engine/Renderer.h>
+#include <Engine/Sprite.h>
+#ifdef ASGE_HEADLESS
+#include <SWTexture.h>
+#endif
+#include "SpritePool.h"
+#include "TextureAtlas.h"
+#include "TextureCache.h"
+
+/**
+*   @brief   Returns the process wide cache.
+*   @details Constructed on first use so that it is available to
+             components created before the game is initialised.
+*   @return  The shared cache.
+*/
+TextureCache& TextureCache::global()
+{
+	static TextureCache cache;
+	return cache;
+}
+
+/**
+*   @brief   Destructor.
+*   @details The cache is destroyed with the process' statics, after
+             the renderer that made its sprites, so any still resident
+             are left alone. Call clear() while the renderer is alive.
+*/
+TextureCache::~TextureCache() = default;
+
+/**
+*   @brief   Creates a sprite bound to a cached texture.
+*   @details The first request for a path loads the texture into a
+             resident sprite which pins it for the lifetime of the
+             entry. Sprites are only able to bind textures by path, so
+             later requests bind to the pinned texture through the
+             renderer's path lookup rather than decoding the file. A
+             hit bound to any other texture than the pinned one means
+             the engine loaded the file again, and is counted.
+*   @return  The new sprite, or nullptr if loading failed.
+*/
+ASGE::Sprite* TextureCache::acquire(
+	ASGE::Renderer* renderer, const std::string& texture_file_name)
+{
+	std::string name;
+	if (auto atlas = resolve(texture_file_name, name))
+	{
+		ASGE::Sprite* sprite = acquire(renderer, atlas->getImageFile(name));
+		if (sprite)
+		{
+			atlas->applyRegion(sprite, name);
+		}
+
+		return sprite;
+	}
+
+	auto found = entries.find(texture_file_name);
+	const bool hit = found != entries.end();
+	if (!hit)
+	{
+		found = load(renderer, texture_file_name);
+		if (found == entries.end())
+		{
+			return nullptr;
+		}
+	}
+	else
+	{
+		counters.hits++;
+		counters.reused_bytes += found->second.bytes;
+	}
+
+	ASGE::Sprite* sprite = SpritePool::global().acquire(renderer);
+	if (!sprite->loadTexture(found->second.bound_file))
+	{
+		SpritePool::global().release(sprite);
+		return nullptr;
+	}
+
+	if (hit && sprite->getTexture() != found->second.resident->getTexture())
+	{
+		counters.reloaded++;
+	}
+
+	found->second.references++;
+	return sprite;
+}
+
+/**
+*   @brief   Loads a texture ahead of its sprites.
+*   @details Counts as a miss when the texture is loaded, so the
+             sprites later created for it are all hits.
+*   @return  True if the texture is resident.
+*/
+bool TextureCache::preload(ASGE::Renderer* renderer, const std::string& texture_file_name)
+{
+	if (isResident(texture_file_name))
+	{
+		return true;
+	}
+
+	return load(renderer, texture_file_name) != entries.end();
+}
+
+/**
+*   @brief   Decodes a texture away from the main thread.
+*   @details Never touches the cache's entries or the renderer, only
+             the cooked cache's index, which is read only once mounted.
+*   @return  True if the pixels are ready.
+*/
+bool TextureCache::decode(const std::string& texture_file_name, TexturePixels& image)
+{
+	if (global().cooked_textures.read(texture_file_name, image))
+	{
+		return true;
+	}
+
+#ifdef ASGE_HEADLESS
+	image.file_name = texture_file_name;
+	image.source_hash = 0;
+	return ASGE::SWTextureCache::decode(texture_file_name, image.width, image.height, image.pixels);
+#else
+	return false;
+#endif
+}
+
+/**
+*   @brief   Uploads decoded pixels.
+*   @details Counts as a miss when the texture is uploaded, the same
+             as preload.
+*   @return  True if the texture is resident.
+*/
+bool TextureCache::upload(ASGE::Renderer* renderer, const TexturePixels& image)
+{
+	if (isResident(image.file_name))
+	{
+		return true;
+	}
+
+	return install(renderer, image) != entries.end();
+}
+
+bool TextureCache::isResident(const std::string& texture_file_name)
+{
+	if (auto atlas = resolve(texture_file_name, resolved_name))
+	{
+		return isResident(atlas->getImageFile(resolved_name));
+	}
+
+	return entries.find(texture_file_name) != entries.end();
+}
+
+/**
+*   @brief   Records a request that reused an existing sprite.
+*   @details Counts as a hit, the sprite already holds its reference.
+*   @return  True if the texture is resident.
+*/
+bool TextureCache::reuse(const std::string& texture_file_name)
+{
+	if (auto atlas = resolve(texture_file_name, resolved_name))
+	{
+		return reuse(atlas->getImageFile(resolved_name));
+	}
+
+	auto found = entries.find(texture_file_name);
+	if (found == entries.end())
+	{
+		return false;
+	}
+
+	counters.hits++;
+	counters.reused_bytes += found->second.bytes;
+	return true;
+}
+
+/**
+*   @brief   Releases a reference.
+*   @details Textures are kept resident until purged, so a level
+             reload that frees and recreates its sprites is served
+             entirely from the cache.
+*   @return  void
+*/
+void TextureCache::release(const std::string& texture_file_name)
+{
+	if (auto atlas = resolve(texture_file_name, resolved_name))
+	{
+		release(atlas->getImageFile(resolved_name));
+		return;
+	}
+
+	auto found = entries.find(texture_file_name);
+	if (found != entries.end() && found->second.references)
+	{
+		found->second.references--;
+	}
+}
+
+/**
+*   @brief   Evicts unreferenced textures.
+*   @details Frees the resident sprite of every entry whose
+             reference count has reached zero.
+*   @return  void
+*/
+void TextureCache::purge()
+{
+	for (auto itr = entries.begin(); itr != entries.end();)
+	{
+		if (itr->second.references)
+		{
+			++itr;
+			continue;
+		}
+
+		counters.textures--;
+		counters.resident_bytes -= itr->second.bytes;
+		delete itr->second.resident;
+		itr = entries.erase(itr);
+	}
+}
+
+void TextureCache::clear()
+{
+	for (auto& entry : entries)
+	{
+		delete entry.second.resident;
+	}
+
+	entries.clear();
+	counters.textures = 0;
+	counters.resident_bytes = 0;
+}
+
+void TextureCache::mount(const TextureAtlas* atlas, const std::string& prefix)
+{
+	mounts.emplace_back(prefix, atlas);
+}
+
+bool TextureCache::mountCooked(const std::string& directory)
+{
+	return cooked_textures.mount(directory);
+}
+
+const CookedTextures& TextureCache::cooked() const noexcept
+{
+	return cooked_textures;
+}
+
+void TextureCache::unmount(const TextureAtlas* atlas)
+{
+	for (auto itr = mounts.begin(); itr != mounts.end();)
+	{
+		itr = itr->second == atlas ? mounts.erase(itr) : itr + 1;
+	}
+}
+
+/**
+*   @brief   Loads a texture into a new resident entry.
+*   @details The resident sprite pins the texture for the lifetime
+             of the entry. Cooked images are read and installed rather
+             than decoded, anything else is loaded from its path.
+*   @return  The new entry, or entries.end() if loading failed.
+*/
+TextureCache::Entries::iterator TextureCache::load(
+	ASGE::Renderer* renderer, const std::string& texture_file_name)
+{
+	TexturePixels image;
+	if (cooked_textures.read(texture_file_name, image))
+	{
+		auto installed = install(renderer, image);
+		if (installed != entries.end())
+		{
+			return installed;
+		}
+	}
+
+	ASGE::Sprite* resident = renderer->createRawSprite();
+	if (!resident->loadTexture(texture_file_name))
+	{
+		delete resident;
+		return entries.end();
+	}
+
+	return add(resident, texture_file_name, texture_file_name);
+}
+
+/**
+*   @brief   Uploads pixels into a new resident entry.
+*   @return  The new entry, or entries.end() if the engine refused them.
+*/
+TextureCache::Entries::iterator TextureCache::install(
+	ASGE::Renderer* renderer, const TexturePixels& image)
+{
+	ASGE::Sprite* resident = renderer->createRawSprite();
+	std::string bound_file;
+	if (!cooked_textures.install(resident, image, bound_file))
+	{
+		delete resident;
+		return entries.end();
+	}
+
+	return add(resident, image.file_name, bound_file);
+}
+
+/**
+*   @brief   Adds a loaded texture's entry and counts it.
+*   @return  The new entry.
+*/
+TextureCache::Entries::iterator TextureCache::add(
+	ASGE::Sprite* resident, const std::string& texture_file_name, const std::string& bound_file)
+{
+	Entry entry;
+	entry.resident = resident;
+	entry.bound_file = bound_file;
+	if (auto texture = resident->getTexture())
+	{
+		entry.bytes = static_cast<size_t>(texture->getWidth()) *
+			texture->getHeight() * texture->getFormat();
+	}
+
+	counters.misses++;
+	counters.textures++;
+	counters.resident_bytes += entry.bytes;
+	return entries.emplace(texture_file_name, entry).first;
+}
+
+/**
+*   @brief   Finds the atlas serving a file, if any.
+*   @details Checks each mount's directory prefix and whether the
+             atlas holds a region named after the rest of the path.
+             The name is written without its extension, as the atlas
+             stores it, and into a string that is reused, so a
+             request for a resident file does not allocate.
+*   @return  The atlas, or nullptr if the file is loaded directly.
+*/
+const TextureAtlas* TextureCache::resolve(
+	const std::string& texture_file_name, std::string& name) const
+{
+	for (const auto& mounted : mounts)
+	{
+		const std::string& prefix = mounted.first;
+		if (texture_file_name.size() > prefix.size() &&
+			texture_file_name.compare(0, prefix.size(), prefix) == 0)
+		{
+			const size_t dot = texture_file_name.find_last_of('.');
+			const size_t end = dot == std::string::npos || dot <= prefix.size() ?
+				texture_file_name.size() : dot;
+			name.assign(texture_file_name, prefix.size(), end - prefix.size());
+			if (mounted.second->find(name))
+			{
+				return mounted.second;
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+const TextureCache::Stats& TextureCache::stats() const noexcept
+{
+	return counters;
+}
+
+void TextureCache::resetCounters() noexcept
+{
+	counters.hits = 0;
+	counters.misses = 0;
+	counters.reloaded = 0;
+	counters.reused_bytes = 0;
+}
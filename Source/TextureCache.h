@@ -0,0 +1,200 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "CookedTextures.h"
+#include "TexturePixels.h"
+
+namespace ASGE {
+	class Renderer;
+	class Sprite;
+}
+
+class TextureAtlas;
+
+/**
+*  A path keyed, reference counted cache of loaded textures.
+*  Every sprite the game creates is requested through here, so each
+*  texture file is read and decoded once per process. Subsequent
+*  requests for the same path are served from the resident copy and
+*  recorded as hits. Entries stay resident after their last reference
+*  is released, so reloading a level never touches the disk again;
+*  call purge() to drop them explicitly, and clear() before the
+*  renderer is destroyed, as the cache outlives it. Baked atlases can be mounted
+*  over a directory, after which requests for files in that directory
+*  are served from the atlas' pages instead.
+*  @see SpriteComponent
+*  @see TextureAtlas
+*/
+class TextureCache
+{
+public:
+
+	/**
+	*  Counters describing how well the cache is doing.
+	*  Hits and misses are cumulative until resetCounters() is called,
+	*  the byte counts describe what is currently resident.
+	*/
+	struct Stats
+	{
+		unsigned int hits = 0;          /**< Requests served by a resident texture. */
+		unsigned int misses = 0;        /**< Requests that had to load from disk. */
+		unsigned int reloaded = 0;      /**< Hits the engine bound to a new copy of the texture. */
+		unsigned int textures = 0;      /**< Number of resident textures. */
+		size_t resident_bytes = 0;      /**< Decoded size of every resident texture. */
+		size_t reused_bytes = 0;        /**< Decoded bytes not reloaded thanks to hits. */
+	};
+
+	/**
+	*  Returns the process wide cache.
+	*  @return the cache shared by every sprite component
+	*/
+	static TextureCache& global();
+
+	/**
+	*  Creates a sprite bound to the texture at the given path.
+	*  On a miss the texture is loaded and kept resident, on a hit the
+	*  sprite is bound to the already resident texture. Either way the
+	*  path's reference count is incremented.
+	*  @param [in] renderer The renderer used to allocate the sprite
+	*  @param [in] texture_file_name The file path to the texture
+	*  @return the new sprite or nullptr if the texture failed to load
+	*/
+	ASGE::Sprite* acquire(ASGE::Renderer* renderer, const std::string& texture_file_name);
+
+	/**
+	*  Loads a texture and keeps it resident without creating a sprite.
+	*  Used to load textures ahead of the sprites that will use them.
+	*  No reference is taken, so purge() may drop it again.
+	*  @param [in] renderer The renderer used to load the texture
+	*  @param [in] texture_file_name The file path to the texture
+	*  @return true if the texture is resident
+	*/
+	bool preload(ASGE::Renderer* renderer, const std::string& texture_file_name);
+
+	/**
+	*  Decodes a texture into memory. May be called from any thread.
+	*  Cooked images are read from the cooked cache. Anything else is
+	*  decoded by the headless engine, while the real engine has no
+	*  decoder outside of loading a path, so there it fails and the
+	*  texture should be preloaded instead. Does not touch the cache.
+	*  @param [in] texture_file_name The file path to the texture
+	*  @param [out] image The decoded pixels
+	*  @return true if the pixels are ready to upload
+	*/
+	static bool decode(const std::string& texture_file_name, TexturePixels& image);
+
+	/**
+	*  Makes decoded pixels a resident texture. Call on the main thread.
+	*  @param [in] renderer The renderer used to create the texture
+	*  @param [in] image The pixels from decode
+	*  @return true if the texture is resident
+	*/
+	bool upload(ASGE::Renderer* renderer, const TexturePixels& image);
+
+	/**
+	*  Checks whether a request would be served without loading.
+	*  @param [in] texture_file_name The file path to the texture
+	*  @return true if the texture is resident or served by an atlas
+	*/
+	bool isResident(const std::string& texture_file_name);
+
+	/**
+	*  Records a request satisfied without creating a sprite.
+	*  Used when a component already holds a sprite for this path, the
+	*  reference count is left untouched.
+	*  @param [in] texture_file_name The file path to the texture
+	*  @return true if the path is resident
+	*/
+	bool reuse(const std::string& texture_file_name);
+
+	/**
+	*  Releases one reference to the texture.
+	*  The texture itself stays resident until purge() is called.
+	*  @param [in] texture_file_name The file path to the texture
+	*/
+	void release(const std::string& texture_file_name);
+
+	/**
+	*  Drops every texture that no longer has any references.
+	*/
+	void purge();
+
+	/**
+	*  Drops every texture, referenced or not. Call while the renderer
+	*  that loaded them is still alive; sprites already acquired keep
+	*  working but their textures are no longer counted.
+	*/
+	void clear();
+
+	/**
+	*  Serves requests for files in a directory from an atlas.
+	*  A request for prefix + name is redirected to the atlas region
+	*  called name, if there is one. Atlases unmount themselves when
+	*  they are destroyed.
+	*  @param [in] atlas The atlas to redirect to
+	*  @param [in] prefix The directory the atlas replaces, including
+	*              its trailing separator
+	*/
+	void mount(const TextureAtlas* atlas, const std::string& prefix);
+
+	/**
+	*  Serves images from a cooked texture cache where it has them.
+	*  Cooked images are then read from the cache rather than decoded
+	*  from their files. Mount before any texture is loaded.
+	*  @param [in] directory The cache's directory, including its
+	*              trailing separator
+	*  @return true if the cache's index was read
+	*/
+	bool mountCooked(const std::string& directory);
+
+	/**
+	*  Returns the cooked texture cache.
+	*/
+	const CookedTextures& cooked() const noexcept;
+
+	/**
+	*  Removes every mount of an atlas.
+	*  @param [in] atlas The atlas previously mounted
+	*/
+	void unmount(const TextureAtlas* atlas);
+
+	/**
+	*  Returns the current statistics.
+	*  @return the hit, miss and byte counters
+	*/
+	const Stats& stats() const noexcept;
+
+	/**
+	*  Zeroes the hit, miss and reused byte counters.
+	*/
+	void resetCounters() noexcept;
+
+private:
+	struct Entry
+	{
+		ASGE::Sprite* resident = nullptr;
+		std::string bound_file;     /**< The path the engine knows the texture by. */
+		unsigned int references = 0;
+		size_t bytes = 0;
+	};
+
+	using Entries = std::unordered_map<std::string, Entry>;
+
+	TextureCache() = default;
+	~TextureCache();
+	TextureCache(const TextureCache&) = delete;
+	TextureCache& operator=(const TextureCache&) = delete;
+
+	Entries::iterator load(ASGE::Renderer* renderer, const std::string& texture_file_name);
+	Entries::iterator install(ASGE::Renderer* renderer, const TexturePixels& image);
+	Entries::iterator add(ASGE::Sprite* resident, const std::string& texture_file_name, const std::string& bound_file);
+	const TextureAtlas* resolve(const std::string& texture_file_name, std::string& name) const;
+
+	Entries entries;
+	std::vector<std::pair<std::string, const TextureAtlas*>> mounts;
+	CookedTextures cooked_textures;
+	std::string resolved_name;
+	Stats counters;
+};
@@ -0,0 +1,20 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+*  An image decoded into memory, ready to become a texture.
+*  Filled on any thread by CookedTextures::read or TextureCache::decode
+*  and handed to the engine on the main thread by CookedTextures::install.
+*  Pixels are 32 bit RGBA, premultiplied for the headless engine and
+*  straight for the real one, as each of them blends.
+*/
+struct TexturePixels
+{
+	std::string file_name;          /**< The game path of the image. */
+	int width = 0;
+	int height = 0;
+	std::vector<uint32_t> pixels;   /**< width * height pixels. */
+	uint64_t source_hash = 0;       /**< The cooked blob's hash, zero if the image was decoded. */
+};
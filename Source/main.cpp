@@ -1,19 +1,41 @@
+#ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
+#endif
+#include <cstdlib>
 #include <Engine/Platform.h>
 #include "Game.h"
 
-int WINAPI WinMain(
-	HINSTANCE hInstance, 
-	HINSTANCE hPrevInstance, 
-	PSTR pScmdline, int iCmdshow)
+/**
+*   @brief   Runs the game.
+*   @details Windows builds start from WinMain, others from main.
+*   @return  The exit code.
+*/
+static int runGame()
 {
 	AngryBirdsGame* game = new AngryBirdsGame;
+	int result = EXIT_FAILURE;
 	if (game->init())
 	{
-		game->run();
+		result = game->run();
 	}
 
 	delete game;
 	game = nullptr;
-}
\ No newline at end of file
+	return result;
+}
+
+#ifdef _WIN32
+int WINAPI WinMain(
+	HINSTANCE hInstance, 
+	HINSTANCE hPrevInstance, 
+	PSTR pScmdline, int iCmdshow)
+{
+	return runGame();
+}
+#else
+int main()
+{
+	return runGame();
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include <cstdio>
+#include <string>
+
+#include <SWRenderer.h>
+#include "TextureAtlas.h"
+#include "TextureCache.h"
+
+// Usage: AtlasCheck
+//
+// Loads Resources/Textures/kenney_physicspack/Spritesheet/
+// spritesheet_elements.xml, whose imagePath names a "sheet.png" that is
+// not shipped, so the sheet is found by the xml's own name. Checks the
+// number of regions, a few rects copied from the xml, that names
+// resolve with and without their extension and that every region is on
+// the one sheet. Exits with 1 if anything is wrong.
+
+namespace
+{
+	const char* const XML_FILE =
+		"Resources\\Textures\\kenney_physicspack\\Spritesheet\\spritesheet_elements.xml";
+	const char* const SHEET_FILE =
+		"Resources\\Textures\\kenney_physicspack\\Spritesheet\\spritesheet_elements.png";
+
+	struct Expected
+	{
+		const char* name;
+		float x, y, width, height;
+	};
+
+	const Expected EXPECTED[] = {
+		{ "elementExplosive000.png", 720, 1290, 140, 70 },
+		{ "elementStone011", 1560, 1430, 70, 70 },
+		{ "elementWood010.png", 1770, 1570, 70, 70 } };
+
+	const size_t EXPECTED_REGIONS = 281;
+
+	bool check(bool ok, const char* what)
+	{
+		std::printf("%-44s %s\n", what, ok ? "ok" : "FAILED");
+		return ok;
+	}
+}
+
+int main()
+{
+	ASGE::SWRenderer renderer;
+	bool passed = true;
+	{
+		TextureAtlas atlas;
+		passed = check(atlas.load(&renderer, XML_FILE), "load") && passed;
+		passed = check(atlas.size() == EXPECTED_REGIONS, "region count") && passed;
+		passed = check(TextureCache::global().isResident(SHEET_FILE), "sheet resident") && passed;
+
+		for (const Expected& expected : EXPECTED)
+		{
+			const rect* region = atlas.find(expected.name);
+			passed = check(region &&
+				region->x == expected.x && region->y == expected.y &&
+				region->length == expected.width && region->height == expected.height,
+				expected.name) && passed;
+			passed = check(atlas.getImageFile(expected.name) == SHEET_FILE, "  on the sheet") && passed;
+		}
+
+		passed = check(atlas.find("elementWood999") == nullptr, "unknown name") && passed;
+	}
+
+	//the atlas released its sheet, the cache's textures go before the renderer
+	TextureCache::global().purge();
+	TextureCache::global().clear();
+	return passed ? 0 : 1;
+}
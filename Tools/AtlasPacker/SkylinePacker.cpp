@@ -0,0 +1,131 @@
+#include <algorithm>
+#include "SkylinePacker.h"
+
+SkylinePacker::SkylinePacker(int width, int height)
+	: bin_width(width), bin_height(height)
+{
+	Segment floor;
+	floor.width = width;
+	skyline.push_back(floor);
+}
+
+/**
+*   @brief   Places a rectangle.
+*   @details Every skyline segment is tried as the left edge of the
+             rectangle, the lowest resulting position wins, with ties
+             going to the narrowest segment to limit wasted space.
+*   @return  True if there was room.
+*/
+bool SkylinePacker::insert(int width, int height, int& x, int& y)
+{
+	int best_top = bin_height + 1;
+	int best_width = bin_width + 1;
+	size_t best_index = skyline.size();
+
+	for (size_t i = 0; i < skyline.size(); i++)
+	{
+		int top = fit(i, width, height);
+		if (top < 0)
+		{
+			continue;
+		}
+
+		if (top + height < best_top ||
+			(top + height == best_top && skyline[i].width < best_width))
+		{
+			best_top = top + height;
+			best_width = skyline[i].width;
+			best_index = i;
+			x = skyline[i].x;
+			y = top;
+		}
+	}
+
+	if (best_index == skyline.size())
+	{
+		return false;
+	}
+
+	place(best_index, x, y, width, height);
+	return true;
+}
+
+/**
+*   @brief   Tests a rectangle against a segment.
+*   @details The rectangle rests on the highest segment it spans.
+*   @return  The y position it would be placed at, or -1.
+*/
+int SkylinePacker::fit(size_t index, int width, int height) const
+{
+	int x = skyline[index].x;
+	if (x + width > bin_width)
+	{
+		return -1;
+	}
+
+	int y = 0;
+	int remaining = width;
+	while (remaining > 0)
+	{
+		if (index == skyline.size())
+		{
+			return -1;
+		}
+
+		y = std::max(y, skyline[index].y);
+		if (y + height > bin_height)
+		{
+			return -1;
+		}
+
+		remaining -= skyline[index].width;
+		index++;
+	}
+
+	return y;
+}
+
+/**
+*   @brief   Adds a placed rectangle to the skyline.
+*   @details Segments covered by the rectangle are shrunk or removed
+             and neighbours at the same height are merged.
+*   @return  void
+*/
+void SkylinePacker::place(size_t index, int x, int y, int width, int height)
+{
+	Segment top;
+	top.x = x;
+	top.y = y + height;
+	top.width = width;
+	skyline.insert(skyline.begin() + index, top);
+
+	for (size_t i = index + 1; i < skyline.size(); i++)
+	{
+		int previous_end = skyline[i - 1].x + skyline[i - 1].width;
+		if (skyline[i].x >= previous_end)
+		{
+			break;
+		}
+
+		int shrink = previous_end - skyline[i].x;
+		skyline[i].x += shrink;
+		skyline[i].width -= shrink;
+		if (skyline[i].width > 0)
+		{
+			break;
+		}
+
+		skyline.erase(skyline.begin() + i);
+		i--;
+	}
+
+	for (size_t i = 0; i + 1 < skyline.size(); i++)
+	{
+		if (skyline[i].y == skyline[i + 1].y)
+		{
+			skyline[i].width += skyline[i + 1].width;
+			skyline.erase(skyline.begin() + i + 1);
+			i--;
+		}
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <vector>
+
+/**
+*  Bottom-left skyline rectangle packer.
+*  Tracks the top edge of everything placed so far as a list of
+*  horizontal segments and places each new rectangle where its top edge
+*  ends up lowest. Works well for sprites sorted by decreasing height.
+*/
+class SkylinePacker
+{
+public:
+
+	/**
+	*  Constructor.
+	*  @param [in] width The width of the area to pack into
+	*  @param [in] height The height of the area to pack into
+	*/
+	SkylinePacker(int width, int height);
+
+	/**
+	*  Finds room for a rectangle and reserves it.
+	*  @param [in] width The rectangle's width
+	*  @param [in] height The rectangle's height
+	*  @param [out] x The rectangle's position if successful
+	*  @param [out] y The rectangle's position if successful
+	*  @return true if the rectangle fits
+	*/
+	bool insert(int width, int height, int& x, int& y);
+
+private:
+	struct Segment
+	{
+		int x = 0;
+		int y = 0;
+		int width = 0;
+	};
+
+	int fit(size_t index, int width, int height) const;
+	void place(size_t index, int x, int y, int width, int height);
+
+	int bin_width = 0;
+	int bin_height = 0;
+	std::vector<Segment> skyline;
+};
@@ -0,0 +1,441 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <png.h>
+
+#include "AtlasIndex.h"
+#include "SkylinePacker.h"
+
+/**
+*  AtlasPacker
+*  Bakes a set of loose images into one or more power of two atlas
+*  pages plus a binary index, see AtlasIndex.h. Runs headless so it
+*  can be invoked as part of the build.
+*
+*  usage: AtlasPacker [-o dir] [-n name] [-s max_size] [-p padding] inputs...
+*  Inputs may be png files or directories containing them.
+*/
+
+namespace fs = std::filesystem;
+
+namespace
+{
+	struct Image
+	{
+		std::string name;
+		int width = 0;
+		int height = 0;
+		std::vector<unsigned char> pixels;
+
+		int page = -1;
+		int x = 0;
+		int y = 0;
+	};
+
+	struct Settings
+	{
+		std::string output_dir = ".";
+		std::string name = "atlas";
+		int max_size = 4096;
+		int padding = 2;
+		std::vector<std::string> inputs;
+	};
+
+	bool loadImage(const fs::path& file, Image& image)
+	{
+		png_image png;
+		std::memset(&png, 0, sizeof(png));
+		png.version = PNG_IMAGE_VERSION;
+
+		if (!png_image_begin_read_from_file(&png, file.string().c_str()))
+		{
+			std::fprintf(stderr, "AtlasPacker: %s: %s\n", file.string().c_str(), png.message);
+			return false;
+		}
+
+		png.format = PNG_FORMAT_RGBA;
+		image.width = static_cast<int>(png.width);
+		image.height = static_cast<int>(png.height);
+		image.pixels.resize(PNG_IMAGE_SIZE(png));
+		if (!png_image_finish_read(&png, nullptr, image.pixels.data(), 0, nullptr))
+		{
+			std::fprintf(stderr, "AtlasPacker: %s: %s\n", file.string().c_str(), png.message);
+			png_image_free(&png);
+			return false;
+		}
+
+		image.name = file.filename().string();
+		return true;
+	}
+
+	bool collectInputs(const Settings& settings, std::vector<Image>& images)
+	{
+		std::vector<fs::path> files;
+		for (const auto& input : settings.inputs)
+		{
+			if (fs::is_directory(input))
+			{
+				for (const auto& entry : fs::directory_iterator(input))
+				{
+					if (entry.path().extension() == ".png")
+					{
+						files.push_back(entry.path());
+					}
+				}
+			}
+			else
+			{
+				files.push_back(input);
+			}
+		}
+
+		//keep the output stable regardless of directory ordering
+		std::sort(files.begin(), files.end(),
+			[](const fs::path& lhs, const fs::path& rhs)
+		{
+			return lhs.filename() < rhs.filename();
+		});
+
+		for (const auto& file : files)
+		{
+			Image image;
+			if (!loadImage(file, image))
+			{
+				return false;
+			}
+
+			images.push_back(std::move(image));
+		}
+
+		return !images.empty();
+	}
+
+	/**
+	*   @brief   Lists the page sizes to try.
+	*   @details Power of two sizes ordered by area, so the smallest
+	             page that fits everything is chosen.
+	*/
+	std::vector<std::pair<int, int>> pageSizes(int max_size)
+	{
+		std::vector<std::pair<int, int>> sizes;
+		for (int w = 64; w <= max_size; w *= 2)
+		{
+			for (int h = 64; h <= w; h *= 2)
+			{
+				sizes.emplace_back(w, h);
+			}
+		}
+
+		std::sort(sizes.begin(), sizes.end(),
+			[](const std::pair<int, int>& lhs, const std::pair<int, int>& rhs)
+		{
+			if (lhs.first * lhs.second != rhs.first * rhs.second)
+			{
+				return lhs.first * lhs.second < rhs.first * rhs.second;
+			}
+
+			return lhs.first < rhs.first;
+		});
+
+		return sizes;
+	}
+
+	/**
+	*   @brief   Packs the images into pages.
+	*   @details Tries to fit all remaining images into the smallest
+	             page possible. If they don't fit into the largest page
+	             it is filled as best it can and a new page started.
+	*/
+	bool pack(const Settings& settings, std::vector<Image>& images,
+		std::vector<std::pair<int, int>>& pages)
+	{
+		std::vector<size_t> remaining;
+		for (size_t i = 0; i < images.size(); i++)
+		{
+			const int padded_width = images[i].width + settings.padding * 2;
+			const int padded_height = images[i].height + settings.padding * 2;
+			if (padded_width > settings.max_size || padded_height > settings.max_size)
+			{
+				std::fprintf(stderr, "AtlasPacker: %s is larger than a page\n", images[i].name.c_str());
+				return false;
+			}
+
+			remaining.push_back(i);
+		}
+
+		std::stable_sort(remaining.begin(), remaining.end(),
+			[&images](size_t lhs, size_t rhs)
+		{
+			if (images[lhs].height != images[rhs].height)
+			{
+				return images[lhs].height > images[rhs].height;
+			}
+
+			return images[lhs].width > images[rhs].width;
+		});
+
+		const auto sizes = pageSizes(settings.max_size);
+		while (!remaining.empty())
+		{
+			const int page = static_cast<int>(pages.size());
+			std::vector<size_t> leftover;
+
+			for (size_t s = 0; s < sizes.size(); s++)
+			{
+				SkylinePacker packer(sizes[s].first, sizes[s].second);
+				const bool last_size = s + 1 == sizes.size();
+				leftover.clear();
+
+				for (auto index : remaining)
+				{
+					Image& image = images[index];
+					int x = 0, y = 0;
+					if (packer.insert(
+						image.width + settings.padding * 2,
+						image.height + settings.padding * 2, x, y))
+					{
+						image.page = page;
+						image.x = x + settings.padding;
+						image.y = y + settings.padding;
+					}
+					else if (last_size)
+					{
+						leftover.push_back(index);
+					}
+					else
+					{
+						leftover.push_back(index);
+						break;
+					}
+				}
+
+				if (leftover.empty() || last_size)
+				{
+					pages.emplace_back(sizes[s].first, sizes[s].second);
+					break;
+				}
+			}
+
+			remaining.swap(leftover);
+		}
+
+		return true;
+	}
+
+	/**
+	*   @brief   Copies an image into its page.
+	*   @details The image's edge pixels are extruded into the padding
+	             so filtering at the border never samples a neighbour.
+	*/
+	void blit(const Image& image, int padding, int page_width, int page_height,
+		std::vector<unsigned char>& page)
+	{
+		for (int y = -padding; y < image.height + padding; y++)
+		{
+			const int dst_y = image.y + y;
+			if (dst_y < 0 || dst_y >= page_height)
+			{
+				continue;
+			}
+
+			const int src_y = std::min(std::max(y, 0), image.height - 1);
+			for (int x = -padding; x < image.width + padding; x++)
+			{
+				const int dst_x = image.x + x;
+				if (dst_x < 0 || dst_x >= page_width)
+				{
+					continue;
+				}
+
+				const int src_x = std::min(std::max(x, 0), image.width - 1);
+				std::memcpy(
+					&page[(static_cast<size_t>(dst_y) * page_width + dst_x) * 4],
+					&image.pixels[(static_cast<size_t>(src_y) * image.width + src_x) * 4], 4);
+			}
+		}
+	}
+
+	bool writePages(const Settings& settings, const std::vector<Image>& images,
+		const std::vector<std::pair<int, int>>& pages, std::vector<std::string>& page_files)
+	{
+		for (size_t p = 0; p < pages.size(); p++)
+		{
+			const int width = pages[p].first;
+			const int height = pages[p].second;
+			std::vector<unsigned char> pixels(static_cast<size_t>(width) * height * 4, 0);
+
+			for (const auto& image : images)
+			{
+				if (image.page == static_cast<int>(p))
+				{
+					blit(image, settings.padding, width, height, pixels);
+				}
+			}
+
+			std::string file_name = settings.name + "_" + std::to_string(p) + ".png";
+			fs::path path = fs::path(settings.output_dir) / file_name;
+
+			png_image png;
+			std::memset(&png, 0, sizeof(png));
+			png.version = PNG_IMAGE_VERSION;
+			png.width = width;
+			png.height = height;
+			png.format = PNG_FORMAT_RGBA;
+			if (!png_image_write_to_file(&png, path.string().c_str(), 0, pixels.data(), 0, nullptr))
+			{
+				std::fprintf(stderr, "AtlasPacker: %s: %s\n", path.string().c_str(), png.message);
+				return false;
+			}
+
+			page_files.push_back(file_name);
+		}
+
+		return true;
+	}
+
+	bool writeIndex(const Settings& settings, const std::vector<Image>& images,
+		const std::vector<std::pair<int, int>>& pages, const std::vector<std::string>& page_files)
+	{
+		std::string strings;
+		auto addString = [&strings](const std::string& value)
+		{
+			auto offset = static_cast<uint32_t>(strings.size());
+			strings.append(value);
+			strings.push_back('\0');
+			return offset;
+		};
+
+		std::vector<AtlasIndex::Page> page_table;
+		for (size_t p = 0; p < pages.size(); p++)
+		{
+			AtlasIndex::Page page;
+			page.file_name = addString(page_files[p]);
+			page.width = static_cast<uint16_t>(pages[p].first);
+			page.height = static_cast<uint16_t>(pages[p].second);
+			page_table.push_back(page);
+		}
+
+		std::vector<AtlasIndex::Entry> entry_table;
+		for (const auto& image : images)
+		{
+			AtlasIndex::Entry entry;
+			entry.name = addString(image.name);
+			entry.page = static_cast<uint16_t>(image.page);
+			entry.x = static_cast<uint16_t>(image.x);
+			entry.y = static_cast<uint16_t>(image.y);
+			entry.width = static_cast<uint16_t>(image.width);
+			entry.height = static_cast<uint16_t>(image.height);
+			entry_table.push_back(entry);
+		}
+
+		AtlasIndex::Header header;
+		std::memcpy(header.magic, AtlasIndex::MAGIC, sizeof(header.magic));
+		header.version = AtlasIndex::VERSION;
+		header.page_count = static_cast<uint16_t>(page_table.size());
+		header.entry_count = static_cast<uint32_t>(entry_table.size());
+		header.string_bytes = static_cast<uint32_t>(strings.size());
+
+		fs::path path = fs::path(settings.output_dir) / (settings.name + ".atlas");
+		std::ofstream file(path, std::ios::binary);
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(page_table.data()),
+			page_table.size() * sizeof(AtlasIndex::Page));
+		file.write(reinterpret_cast<const char*>(entry_table.data()),
+			entry_table.size() * sizeof(AtlasIndex::Entry));
+		file.write(strings.data(), strings.size());
+
+		if (!file)
+		{
+			std::fprintf(stderr, "AtlasPacker: failed to write %s\n", path.string().c_str());
+			return false;
+		}
+
+		return true;
+	}
+
+	bool parseArguments(int argc, char* argv[], Settings& settings)
+	{
+		for (int i = 1; i < argc; i++)
+		{
+			std::string arg = argv[i];
+			bool has_value = i + 1 < argc;
+
+			if (arg == "-o" && has_value)
+			{
+				settings.output_dir = argv[++i];
+			}
+			else if (arg == "-n" && has_value)
+			{
+				settings.name = argv[++i];
+			}
+			else if (arg == "-s" && has_value)
+			{
+				settings.max_size = std::atoi(argv[++i]);
+			}
+			else if (arg == "-p" && has_value)
+			{
+				settings.padding = std::atoi(argv[++i]);
+			}
+			else if (!arg.empty() && arg[0] == '-')
+			{
+				return false;
+			}
+			else
+			{
+				settings.inputs.push_back(arg);
+			}
+		}
+
+		return !settings.inputs.empty() &&
+			settings.max_size >= 64 && settings.max_size <= 65535 &&
+			settings.padding >= 0;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	Settings settings;
+	if (!parseArguments(argc, argv, settings))
+	{
+		std::fprintf(stderr,
+			"usage: AtlasPacker [-o dir] [-n name] [-s max_size] [-p padding] inputs...\n");
+		return 1;
+	}
+
+	std::vector<Image> images;
+	if (!collectInputs(settings, images))
+	{
+		return 1;
+	}
+
+	std::vector<std::pair<int, int>> pages;
+	if (!pack(settings, images, pages))
+	{
+		return 1;
+	}
+
+	std::error_code error;
+	fs::create_directories(settings.output_dir, error);
+
+	std::vector<std::string> page_files;
+	if (!writePages(settings, images, pages, page_files) ||
+		!writeIndex(settings, images, pages, page_files))
+	{
+		return 1;
+	}
+
+	std::printf("AtlasPacker: packed %zu images into %zu page(s)\n",
+		images.size(), pages.size());
+	for (size_t p = 0; p < pages.size(); p++)
+	{
+		std::printf("  %s %dx%d\n", page_files[p].c_str(), pages[p].first, pages[p].second);
+	}
+
+	return 0;
+}
@@ -0,0 +1,295 @@
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "LevelFormat.h"
+
+/**
+*  LevelCompiler
+*  Compiles text level files into the binary pack the game maps, see
+*  LevelFormat.h. Levels are packed in the order they appear, the
+*  first level of the first file being level 1.
+*
+*  usage: LevelCompiler -o output.lvl inputs...
+*
+*  The text format is one statement per line, # starts a comment:
+*    material <name> <texture> <damaged texture or -> <hit points> <score>
+*    level <name>
+*      king <x> <y>
+*      army <x> <y>
+*      projectiles <count>
+*      par <score>
+*      structure <material> <x> <y>
+*    end
+*  Materials must be declared before the structures that use them.
+*/
+
+namespace fs = std::filesystem;
+
+namespace
+{
+	struct Pack
+	{
+		std::vector<LevelFormat::Material> materials;
+		std::vector<std::string> material_names;
+		std::vector<LevelFormat::Level> levels;
+		std::vector<LevelFormat::Structure> structures;
+		std::string strings;
+
+		uint32_t addString(const std::string& value)
+		{
+			auto offset = static_cast<uint32_t>(strings.size());
+			strings.append(value);
+			strings.push_back('\0');
+			return offset;
+		}
+
+		int findMaterial(const std::string& name) const
+		{
+			for (size_t i = 0; i < material_names.size(); i++)
+			{
+				if (material_names[i] == name)
+				{
+					return static_cast<int>(i);
+				}
+			}
+
+			return -1;
+		}
+	};
+
+	/**
+	*   @brief   Reports an error against a line of a level file.
+	*   @return  Always false, so callers can return it.
+	*/
+	bool fail(const std::string& file, int line, const std::string& message)
+	{
+		std::fprintf(stderr, "LevelCompiler: %s:%d: %s\n", file.c_str(), line, message.c_str());
+		return false;
+	}
+
+	/**
+	*   @brief   Reads the rest of a statement's values.
+	*   @details Fails if any are missing or there are extra words.
+	*   @return  True if every value was read.
+	*/
+	template <typename... Values>
+	bool readValues(std::istringstream& words, Values&... values)
+	{
+		bool read = static_cast<bool>((words >> ... >> values));
+		std::string extra;
+		return read && !(words >> extra);
+	}
+
+	bool compileFile(const std::string& file_name, Pack& pack)
+	{
+		std::ifstream file(file_name);
+		if (!file)
+		{
+			return fail(file_name, 0, "cannot open file");
+		}
+
+		bool in_level = false;
+		LevelFormat::Level level{};
+		std::string text;
+		for (int line = 1; std::getline(file, text); line++)
+		{
+			auto comment = text.find('#');
+			if (comment != std::string::npos)
+			{
+				text.erase(comment);
+			}
+
+			std::istringstream words(text);
+			std::string keyword;
+			if (!(words >> keyword))
+			{
+				continue;
+			}
+
+			if (keyword == "material")
+			{
+				std::string name, texture, damaged;
+				unsigned int hit_points = 0, score = 0;
+				if (in_level || !readValues(words, name, texture, damaged, hit_points, score) ||
+					hit_points > 0xFFFF || score > 0xFFFF)
+				{
+					return fail(file_name, line, "expected material <name> <texture> <damaged texture or -> <hit points> <score> outside a level");
+				}
+
+				if (pack.findMaterial(name) >= 0)
+				{
+					return fail(file_name, line, "material " + name + " is already declared");
+				}
+
+				LevelFormat::Material material{};
+				material.name = pack.addString(name);
+				material.texture = pack.addString(texture);
+				material.damaged_texture = damaged == "-" ? LevelFormat::NO_STRING : pack.addString(damaged);
+				material.hit_points = static_cast<uint16_t>(hit_points);
+				material.score = static_cast<uint16_t>(score);
+				pack.materials.push_back(material);
+				pack.material_names.push_back(name);
+			}
+			else if (keyword == "level")
+			{
+				std::string name;
+				if (in_level || !readValues(words, name))
+				{
+					return fail(file_name, line, "expected level <name> after the previous level's end");
+				}
+
+				level = LevelFormat::Level{};
+				level.name = pack.addString(name);
+				level.first_structure = static_cast<uint32_t>(pack.structures.size());
+				level.projectiles = 8;
+				in_level = true;
+			}
+			else if (!in_level)
+			{
+				return fail(file_name, line, keyword + " outside a level");
+			}
+			else if (keyword == "king")
+			{
+				if (!readValues(words, level.king_x, level.king_y))
+				{
+					return fail(file_name, line, "expected king <x> <y>");
+				}
+			}
+			else if (keyword == "army")
+			{
+				if (!readValues(words, level.army_x, level.army_y))
+				{
+					return fail(file_name, line, "expected army <x> <y>");
+				}
+			}
+			else if (keyword == "projectiles" || keyword == "par")
+			{
+				unsigned int value = 0;
+				if (!readValues(words, value) || value > 0xFFFF)
+				{
+					return fail(file_name, line, "expected " + keyword + " <count>");
+				}
+
+				(keyword == "par" ? level.par_score : level.projectiles) = static_cast<uint16_t>(value);
+			}
+			else if (keyword == "structure")
+			{
+				std::string material;
+				LevelFormat::Structure structure{};
+				if (!readValues(words, material, structure.x, structure.y))
+				{
+					return fail(file_name, line, "expected structure <material> <x> <y>");
+				}
+
+				const int index = pack.findMaterial(material);
+				if (index < 0)
+				{
+					return fail(file_name, line, "unknown material " + material);
+				}
+
+				structure.material = static_cast<uint16_t>(index);
+				pack.structures.push_back(structure);
+			}
+			else if (keyword == "end")
+			{
+				level.structure_count = static_cast<uint32_t>(pack.structures.size()) - level.first_structure;
+				pack.levels.push_back(level);
+				in_level = false;
+			}
+			else
+			{
+				return fail(file_name, line, "unknown statement " + keyword);
+			}
+		}
+
+		return in_level ? fail(file_name, 0, "the last level has no end") : true;
+	}
+
+	bool writePack(const std::string& output, const Pack& pack)
+	{
+		LevelFormat::Header header{};
+		std::memcpy(header.magic, LevelFormat::MAGIC, sizeof(header.magic));
+		header.version = LevelFormat::VERSION;
+		header.level_count = static_cast<uint16_t>(pack.levels.size());
+		header.material_count = static_cast<uint16_t>(pack.materials.size());
+		header.structure_count = static_cast<uint32_t>(pack.structures.size());
+		header.string_bytes = static_cast<uint32_t>(pack.strings.size());
+
+		std::error_code error;
+		const fs::path path(output);
+		if (path.has_parent_path())
+		{
+			fs::create_directories(path.parent_path(), error);
+		}
+
+		std::ofstream file(path, std::ios::binary);
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(pack.materials.data()),
+			pack.materials.size() * sizeof(LevelFormat::Material));
+		file.write(reinterpret_cast<const char*>(pack.levels.data()),
+			pack.levels.size() * sizeof(LevelFormat::Level));
+		file.write(reinterpret_cast<const char*>(pack.structures.data()),
+			pack.structures.size() * sizeof(LevelFormat::Structure));
+		file.write(pack.strings.data(), pack.strings.size());
+
+		if (!file)
+		{
+			std::fprintf(stderr, "LevelCompiler: failed to write %s\n", output.c_str());
+			return false;
+		}
+
+		return true;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	std::string output;
+	std::vector<std::string> inputs;
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+		{
+			output = argv[++i];
+		}
+		else
+		{
+			inputs.push_back(argv[i]);
+		}
+	}
+
+	if (output.empty() || inputs.empty())
+	{
+		std::fprintf(stderr, "usage: LevelCompiler -o output.lvl inputs...\n");
+		return 1;
+	}
+
+	Pack pack;
+	for (const auto& input : inputs)
+	{
+		if (!compileFile(input, pack))
+		{
+			return 1;
+		}
+	}
+
+	if (pack.levels.empty() || pack.levels.size() > 0xFFFF || pack.materials.size() > 0xFFFF)
+	{
+		std::fprintf(stderr, "LevelCompiler: expected between 1 and 65535 levels and materials\n");
+		return 1;
+	}
+
+	if (!writePack(output, pack))
+	{
+		return 1;
+	}
+
+	std::printf("LevelCompiler: compiled %zu levels, %zu materials and %zu structures\n",
+		pack.levels.size(), pack.materials.size(), pack.structures.size());
+	return 0;
+}
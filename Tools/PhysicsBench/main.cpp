@@ -0,0 +1,281 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "JobSystem.h"
+#include "PhysicsWorld.h"
+
+// Usage: PhysicsBench [towers] [storeys] [scaling towers] [threads]
+//
+// Each storey is two 70x140 pillars under a 220x70 plank, the sizes of
+// the Kenney physics pack's wood elements. The towers settle for two
+// seconds, sit for one more while we measure how far the blocks creep,
+// then take a rock each and are left for three seconds to fall and
+// sleep again. Prints the step times for each phase against the
+// 8.33ms a 120 Hz tick allows.
+//
+// Then builds a larger scene of separate towers that are kept awake and
+// steps it with 1, 2, 4... threads up to the given count, or the
+// hardware's count but at least 2, printing the step time and a hash of
+// the final state. The hashes must match, as islands are solved the same
+// way whichever thread gets them, and every run on 2 or more threads
+// must have solved its islands on the job system. Threads are started
+// even beyond the hardware's count, so a single core machine still
+// checks the parallel path, if not its speed.
+//
+// The same is done for a scene of towers added asleep, each with an
+// awake crate resting on its roof, hit by rocks from the right. The
+// crate's contact with the roof is found before the rock's, so the roof
+// is only solved as one body if it is woken before any contact is
+// built.
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	const float TICK = 1.0f / 120.0f;
+	const float GROUND_Y = 1000.0f;
+	const float TOWER_SPACING = 320.0f;
+
+	struct Phase
+	{
+		const char* name;
+		float seconds;
+	};
+
+	std::vector<int> buildTowers(PhysicsWorld& world, int towers, int storeys, bool awake = true)
+	{
+		PhysicsWorld::BodyDef ground;
+		ground.bounds = rect{ -1000.0f, GROUND_Y, towers * TOWER_SPACING + 2000.0f, 100.0f };
+		ground.mass = 0;
+		world.addBody(ground);
+
+		std::vector<int> blocks;
+		for (int t = 0; t < towers; t++)
+		{
+			const float left = t * TOWER_SPACING;
+			float floor = GROUND_Y;
+			for (int s = 0; s < storeys; s++)
+			{
+				PhysicsWorld::BodyDef pillar;
+				pillar.awake = awake;
+				pillar.bounds = rect{ left, floor - 140.0f, 70.0f, 140.0f };
+				blocks.push_back(world.addBody(pillar));
+				pillar.bounds.x = left + 150.0f;
+				blocks.push_back(world.addBody(pillar));
+
+				PhysicsWorld::BodyDef plank;
+				plank.awake = awake;
+				plank.bounds = rect{ left, floor - 210.0f, 220.0f, 70.0f };
+				blocks.push_back(world.addBody(plank));
+				floor -= 210.0f;
+			}
+		}
+
+		return blocks;
+	}
+
+	void fireRocks(PhysicsWorld& world, int towers, int storeys)
+	{
+		for (int t = 0; t < towers; t += 2)
+		{
+			PhysicsWorld::BodyDef rock;
+			const float height = GROUND_Y - 210.0f * (1 + t % std::max(1, storeys)) + 40.0f;
+			rock.bounds = rect{ t * TOWER_SPACING - 120.0f, height, 30.0f, 30.0f };
+			rock.mass = 8.0f;
+			rock.velocity_x = 1500.0f;
+			rock.restitution = 0.3f;
+			world.addBody(rock);
+		}
+	}
+
+	void dropCrates(PhysicsWorld& world, int towers, int storeys)
+	{
+		for (int t = 0; t < towers; t++)
+		{
+			PhysicsWorld::BodyDef crate;
+			crate.bounds = rect{ t * TOWER_SPACING + 10.0f, GROUND_Y - 210.0f * storeys - 50.0f, 50.0f, 50.0f };
+			world.addBody(crate);
+		}
+	}
+
+	void fireRocksFromRight(PhysicsWorld& world, int towers, int storeys)
+	{
+		for (int t = 0; t < towers; t++)
+		{
+			PhysicsWorld::BodyDef rock;
+			rock.bounds = rect{ t * TOWER_SPACING + 260.0f, GROUND_Y - 210.0f * storeys + 20.0f, 30.0f, 30.0f };
+			rock.mass = 8.0f;
+			rock.velocity_x = -1500.0f;
+			rock.restitution = 0.3f;
+			world.addBody(rock);
+		}
+	}
+
+	uint64_t hashState(const PhysicsWorld& world, size_t bodies)
+	{
+		uint64_t hash = 14695981039346656037ull;
+		auto mix = [&hash](float value)
+		{
+			unsigned char bytes[sizeof(float)];
+			std::memcpy(bytes, &value, sizeof(float));
+			for (unsigned char byte : bytes)
+			{
+				hash = (hash ^ byte) * 1099511628211ull;
+			}
+		};
+
+		for (size_t id = 0; id < bodies; id++)
+		{
+			const rect box = world.bounds(static_cast<int>(id));
+			mix(box.x);
+			mix(box.y);
+			mix(world.velocityX(static_cast<int>(id)));
+			mix(world.velocityY(static_cast<int>(id)));
+		}
+
+		return hash;
+	}
+
+	bool scaling(int towers, int storeys, unsigned int max_threads, bool sleeping)
+	{
+		const unsigned int most = std::max(1u, max_threads);
+		std::printf("\n%d %s towers of %d storeys\n", towers, sleeping ? "sleeping" : "awake", storeys);
+		std::printf("%-8s %8s %8s %8s %8s %16s\n", "threads", "avg ms", "speedup", "islands", "parallel", "state hash");
+
+		double single = 0;
+		uint64_t expected = 0;
+		bool identical = true;
+		bool parallel = true;
+		for (unsigned int threads = 1; ; threads = std::min(threads * 2, most))
+		{
+			JobSystem jobs(threads);
+			PhysicsWorld world;
+			world.setJobSystem(&jobs);
+			size_t bodies = 0;
+			if (sleeping)
+			{
+				bodies = buildTowers(world, towers, storeys, false).size() + 1;
+				dropCrates(world, towers, storeys);
+				fireRocksFromRight(world, towers, storeys);
+				bodies += 2 * towers;
+			}
+			else
+			{
+				world.sleep_delay = 1e9f;
+				bodies = buildTowers(world, towers, storeys).size() + 1;
+				fireRocks(world, towers, storeys);
+			}
+
+			const int steps = 240;
+			int parallel_steps = 0;
+			const auto start = Clock::now();
+			for (int i = 0; i < steps; i++)
+			{
+				world.step(TICK);
+				parallel_steps += world.stats().parallel ? 1 : 0;
+			}
+			const double average = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / steps;
+
+			const uint64_t hash = hashState(world, bodies);
+			if (threads == 1)
+			{
+				single = average;
+				expected = hash;
+			}
+			identical = identical && hash == expected;
+			parallel = parallel && (threads < 2 || parallel_steps > 0);
+
+			std::printf("%-8u %8.3f %8.2f %8zu %8d %016llx\n", threads, average, single / average,
+				world.stats().islands, parallel_steps, static_cast<unsigned long long>(hash));
+			if (threads == most)
+			{
+				break;
+			}
+		}
+
+		std::printf("%s\n", identical ? "identical on every thread count" : "results differ between thread counts");
+		if (!parallel)
+		{
+			std::printf("the job system never ran, use more scaling towers\n");
+		}
+		return identical && parallel;
+	}
+
+	float creep(const PhysicsWorld& world, const std::vector<int>& blocks, const std::vector<rect>& before)
+	{
+		float furthest = 0;
+		for (size_t i = 0; i < blocks.size(); i++)
+		{
+			const rect now = world.bounds(blocks[i]);
+			furthest = std::max(furthest, std::hypot(now.x - before[i].x, now.y - before[i].y));
+		}
+
+		return furthest;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	const int towers = argc > 1 ? std::atoi(argv[1]) : 40;
+	const int storeys = argc > 2 ? std::atoi(argv[2]) : 4;
+	const int scaling_towers = argc > 3 ? std::atoi(argv[3]) : 400;
+	const unsigned int max_threads = argc > 4 ? std::atoi(argv[4]) : std::max(2u, std::thread::hardware_concurrency());
+
+	PhysicsWorld world;
+	const std::vector<int> blocks = buildTowers(world, towers, storeys);
+	std::printf("%d towers of %d storeys, %zu blocks, %.2f ms per tick allowed\n",
+		towers, storeys, blocks.size(), TICK * 1000.0f);
+	std::printf("%-8s %8s %8s %8s %8s %8s %9s\n",
+		"phase", "avg ms", "p99 ms", "max ms", "awake", "contacts", "creep px");
+
+	const Phase phases[] = { { "settle", 2.0f }, { "rest", 1.0f }, { "impact", 3.0f } };
+	std::vector<double> times;
+	std::vector<rect> before;
+	double worst_p99 = 0;
+	for (const Phase& phase : phases)
+	{
+		if (phase.name == phases[2].name)
+		{
+			fireRocks(world, towers, storeys);
+		}
+
+		before.clear();
+		for (int id : blocks)
+		{
+			before.push_back(world.bounds(id));
+		}
+
+		times.clear();
+		const int steps = static_cast<int>(phase.seconds / TICK);
+		for (int i = 0; i < steps; i++)
+		{
+			const auto start = Clock::now();
+			world.step(TICK);
+			times.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+		}
+
+		double total = 0;
+		for (double t : times)
+		{
+			total += t;
+		}
+		std::sort(times.begin(), times.end());
+		const double p99 = times[static_cast<size_t>(std::ceil(0.99 * times.size())) - 1];
+		worst_p99 = std::max(worst_p99, p99);
+
+		std::printf("%-8s %8.3f %8.3f %8.3f %8zu %8zu %9.2f\n",
+			phase.name, total / times.size(), p99, times.back(),
+			world.stats().awake, world.stats().contacts, creep(world, blocks, before));
+	}
+
+	std::printf("%s\n", worst_p99 <= TICK * 1000.0 ? "within budget" : "over budget");
+	const bool awake_agree = scaling(scaling_towers, storeys, max_threads, false);
+	const bool sleeping_agree = scaling(scaling_towers, storeys, max_threads, true);
+	return awake_agree && sleeping_agree ? 0 : 1;
+}
@@ -0,0 +1,161 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "Rect.h"
+#include "RectBatch.h"
+
+// Usage: RectBench [queries]
+//
+// For several set sizes, tests the same random boxes and rays against
+// the same random rects with rect::isInside, the scalar RectBatch path
+// and the SIMD RectBatch path, and prints the time per rect tested.
+// Exits with 1 if any of them disagree.
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	// keeps the optimiser from dropping the timed loops
+	volatile size_t sink = 0;
+
+	struct Scene
+	{
+		std::vector<rect> rects;
+		RectBatch batch;
+		std::vector<rect> boxes;
+		std::vector<float> rays;
+	};
+
+	rect randomRect(std::mt19937& rng, float max_size)
+	{
+		std::uniform_real_distribution<float> position(0.0f, 1600.0f);
+		std::uniform_real_distribution<float> size(1.0f, max_size);
+		rect r;
+		r.x = position(rng);
+		r.y = position(rng) * 0.5f;
+		r.length = size(rng);
+		r.height = size(rng);
+		return r;
+	}
+
+	Scene makeScene(size_t count, size_t queries, std::mt19937& rng)
+	{
+		Scene scene;
+		scene.batch.reserve(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			scene.rects.push_back(randomRect(rng, 120.0f));
+			scene.batch.add(scene.rects.back());
+		}
+
+		std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+		for (size_t i = 0; i < queries; i++)
+		{
+			scene.boxes.push_back(randomRect(rng, 60.0f));
+			scene.rays.push_back(scene.boxes.back().x);
+			scene.rays.push_back(scene.boxes.back().y);
+			scene.rays.push_back(unit(rng));
+			scene.rays.push_back(unit(rng));
+		}
+
+		return scene;
+	}
+
+	template <typename Test>
+	double nanosecondsPerRect(const Scene& scene, Test test)
+	{
+		const auto start = Clock::now();
+		for (size_t q = 0; q < scene.boxes.size(); q++)
+		{
+			sink = sink + test(q);
+		}
+		const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+		return ns / (scene.boxes.size() * scene.rects.size());
+	}
+
+	bool sameMasks(const Scene& scene, size_t q, std::vector<uint64_t>& a, std::vector<uint64_t>& b)
+	{
+		scene.batch.overlapsScalar(scene.boxes[q], a);
+		scene.batch.overlaps(scene.boxes[q], b);
+		for (size_t i = 0; i < scene.rects.size(); i++)
+		{
+			if (RectBatch::isSet(a, i) != scene.boxes[q].isInside(scene.rects[i]))
+			{
+				return false;
+			}
+		}
+
+		const float* ray = &scene.rays[q * 4];
+		const bool same_boxes = a == b;
+		scene.batch.raycastScalar(ray[0], ray[1], ray[2], ray[3], 800.0f, a);
+		scene.batch.raycast(ray[0], ray[1], ray[2], ray[3], 800.0f, b);
+		return same_boxes && a == b;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	const size_t queries = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000;
+	std::mt19937 rng(12345);
+
+	std::printf("kernel %s, %d lanes, %zu queries per size, ns per rect\n",
+		RectBatch::kernel(), RectBatch::lanes(), queries);
+	std::printf("%8s %10s %10s %10s %10s %10s\n",
+		"rects", "isInside", "scalar", "batch", "ray scalar", "ray batch");
+
+	bool agree = true;
+	for (size_t count : { 8, 64, 512, 4096, 32768 })
+	{
+		const Scene scene = makeScene(count, queries, rng);
+		std::vector<uint64_t> mask;
+		std::vector<uint64_t> other;
+
+		for (size_t q = 0; q < scene.boxes.size() && agree; q++)
+		{
+			agree = sameMasks(scene, q, mask, other);
+		}
+
+		const double pairwise = nanosecondsPerRect(scene, [&](size_t q)
+		{
+			size_t hits = 0;
+			for (const rect& r : scene.rects)
+			{
+				hits += scene.boxes[q].isInside(r);
+			}
+			return hits;
+		});
+		const double scalar = nanosecondsPerRect(scene, [&](size_t q)
+		{
+			return scene.batch.overlapsScalar(scene.boxes[q], mask);
+		});
+		const double batch = nanosecondsPerRect(scene, [&](size_t q)
+		{
+			return scene.batch.overlaps(scene.boxes[q], mask);
+		});
+		const double ray_scalar = nanosecondsPerRect(scene, [&](size_t q)
+		{
+			const float* ray = &scene.rays[q * 4];
+			return scene.batch.raycastScalar(ray[0], ray[1], ray[2], ray[3], 800.0f, mask);
+		});
+		const double ray_batch = nanosecondsPerRect(scene, [&](size_t q)
+		{
+			const float* ray = &scene.rays[q * 4];
+			return scene.batch.raycast(ray[0], ray[1], ray[2], ray[3], 800.0f, mask);
+		});
+
+		std::printf("%8zu %10.3f %10.3f %10.3f %10.3f %10.3f\n",
+			count, pairwise, scalar, batch, ray_scalar, ray_batch);
+	}
+
+	if (!agree)
+	{
+		std::fprintf(stderr, "RectBench: the kernels disagree\n");
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <SWRenderer.h>
+#include <SWTexture.h>
+#include "TextureBatch.h"
+#include "TextureCache.h"
+
+// Usage: TextureBench [runs] [max threads]
+//
+// Loads the images the game starts with from Resources/images, first
+// one at a time through TextureCache::preload, then as a TextureBatch
+// on 1, 2, 4... threads up to the hardware's count (or max threads if
+// given). Then does both again with the cooked texture cache in
+// Resources/cooked mounted, if the build cooked one. Every run starts
+// with both texture caches emptied, and the fastest of runs is
+// printed. Exits with 1 if any image fails to load.
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	const char* const IMAGES[] = {
+		"menu_title.png", "menu_start.png", "menu_exit.png", "gameover.png",
+		"okay.png", "levels_complete.png", "level_start.png", "level1_intro.png",
+		"level2_intro.png", "level3_intro.png", "cursor.png", "foreground.png",
+		"overlay.png", "army.png", "king.png", "catapult.png", "fire_limit.png",
+		"rock1.png", "building_brick1.png", "building_brick1_roof.png",
+		"building_brick1_roof_dmg.png" };
+
+	const char* const COOKED_DIRECTORY = "Resources\\cooked\\";
+	bool use_cooked = false;
+
+	void empty()
+	{
+		TextureCache::global().purge();
+		ASGE::SWTextureCache::global().clear();
+
+		//remounting forgets which cooked images were installed
+		if (use_cooked)
+		{
+			TextureCache::global().mountCooked(COOKED_DIRECTORY);
+		}
+	}
+
+	double serial(ASGE::Renderer* renderer, const std::vector<std::string>& files, bool& loaded)
+	{
+		empty();
+		const auto start = Clock::now();
+		for (const auto& file : files)
+		{
+			loaded = TextureCache::global().preload(renderer, file) && loaded;
+		}
+
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+
+	TextureBatch::Timing batched(ASGE::Renderer* renderer, const std::vector<std::string>& files,
+		unsigned int threads, bool& loaded)
+	{
+		empty();
+		TextureBatch batch;
+		for (const auto& file : files)
+		{
+			batch.add(file);
+		}
+
+		loaded = batch.load(renderer, threads) && loaded;
+		return batch.timing();
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	const int runs = argc > 1 ? std::max(1, std::atoi(argv[1])) : 3;
+	const unsigned int hardware = std::max(1u, argc > 2 ?
+		static_cast<unsigned int>(std::atoi(argv[2])) : std::thread::hardware_concurrency());
+
+	std::vector<std::string> files;
+	for (const char* image : IMAGES)
+	{
+		files.push_back(std::string("Resources\\images\\") + image);
+	}
+
+	ASGE::SWRenderer renderer;
+	bool loaded = true;
+	std::printf("%zu images, best of %d runs\n", files.size(), runs);
+	std::printf("%-8s %10s %10s %10s %8s\n", "threads", "total ms", "decode ms", "upload ms", "speedup");
+
+	double single = 0;
+	for (int pass = 0; pass < 2; pass++)
+	{
+		if (pass == 1)
+		{
+			use_cooked = TextureCache::global().mountCooked(COOKED_DIRECTORY);
+			if (!use_cooked)
+			{
+				std::printf("no cooked texture cache in %s\n", COOKED_DIRECTORY);
+				break;
+			}
+			std::printf("cooked\n");
+		}
+
+		double serial_ms = 1e9;
+		for (int run = 0; run < runs; run++)
+		{
+			serial_ms = std::min(serial_ms, serial(&renderer, files, loaded));
+		}
+
+		single = pass == 0 ? serial_ms : single;
+		std::printf("%-8s %10.2f %10s %10s %8.2f\n", "serial", serial_ms, "-", "-", single / serial_ms);
+
+		for (unsigned int threads = 1; ; threads = std::min(threads * 2, hardware))
+		{
+			TextureBatch::Timing best;
+			double best_total = 1e9;
+			for (int run = 0; run < runs; run++)
+			{
+				const TextureBatch::Timing timing = batched(&renderer, files, threads, loaded);
+				if (timing.decode_ms + timing.upload_ms < best_total)
+				{
+					best = timing;
+					best_total = timing.decode_ms + timing.upload_ms;
+				}
+			}
+
+			std::printf("%-8u %10.2f %10.2f %10.2f %8.2f\n", best.threads, best_total,
+				best.decode_ms, best.upload_ms, single / best_total);
+			if (threads == hardware)
+			{
+				break;
+			}
+		}
+	}
+
+	TextureCache::global().clear();
+	if (!loaded)
+	{
+		std::printf("some images failed to load, run from the build directory\n");
+		return 1;
+	}
+
+	return 0;
+}
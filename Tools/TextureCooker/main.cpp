@@ -0,0 +1,307 @@
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <png.h>
+#include <SWTexture.h>
+#include "CookedFormat.h"
+
+/**
+*  TextureCooker
+*  Cooks images into the pre-decoded cache described in CookedFormat.h.
+*  Each image is decoded by the headless engine and written as a blob
+*  of premultiplied pixels named after the hash of the image's bytes,
+*  along with a blank shell png of the same size, then an index maps
+*  every image's path to its blob. Blobs whose image has not changed
+*  are kept rather than cooked again, and blobs and shells no longer in
+*  the index are deleted.
+*
+*  usage: TextureCooker -o output directory -r root paths...
+*
+*  Paths are relative to root and are stored in the index as given, so
+*  root should be the directory the game runs from. A path naming a
+*  directory cooks every png in it.
+*/
+
+namespace fs = std::filesystem;
+
+namespace
+{
+	struct Image
+	{
+		std::string path;
+		uint64_t hash = 0;
+	};
+
+	/**
+	*   @brief   Hashes a file's bytes with 64 bit FNV-1a.
+	*   @return  False if the file could not be read.
+	*/
+	bool hashFile(const fs::path& file_name, uint64_t& hash)
+	{
+		std::ifstream file(file_name, std::ios::binary);
+		if (!file)
+		{
+			return false;
+		}
+
+		hash = 14695981039346656037ull;
+		char buffer[64 * 1024];
+		while (file.read(buffer, sizeof(buffer)) || file.gcount())
+		{
+			for (std::streamsize i = 0; i < file.gcount(); i++)
+			{
+				hash = (hash ^ static_cast<unsigned char>(buffer[i])) * 1099511628211ull;
+			}
+		}
+
+		return file.eof();
+	}
+
+	std::string blobName(uint64_t hash)
+	{
+		char name[24];
+		std::snprintf(name, sizeof(name), "%016" PRIx64 ".tex", hash);
+		return name;
+	}
+
+	fs::path shellOf(const fs::path& blob)
+	{
+		fs::path shell = blob;
+		return shell.replace_extension(".png");
+	}
+
+	/**
+	*   @brief   Writes a blob's shell.
+	*   @details Every pixel is transparent black, which deflates to
+	             next to nothing and inflates about as fast as the file
+	             can be read.
+	*   @return  False if the file could not be written.
+	*/
+	bool writeShell(const fs::path& shell, int width, int height)
+	{
+		png_image png;
+		std::memset(&png, 0, sizeof(png));
+		png.version = PNG_IMAGE_VERSION;
+		png.width = static_cast<png_uint_32>(width);
+		png.height = static_cast<png_uint_32>(height);
+		png.format = PNG_FORMAT_RGBA;
+
+		const std::vector<uint32_t> blank(size_t(width) * height, 0);
+		if (!png_image_write_to_file(&png, shell.string().c_str(), 0, blank.data(), 0, nullptr))
+		{
+			std::fprintf(stderr, "TextureCooker: failed to write %s\n", shell.string().c_str());
+			return false;
+		}
+
+		return true;
+	}
+
+	/**
+	*   @brief   Checks whether a blob already holds an image.
+	*   @return  True if the blob's header matches the hash and its size
+	             matches the header.
+	*/
+	bool blobIsCurrent(const fs::path& blob, uint64_t hash)
+	{
+		std::ifstream file(blob, std::ios::binary | std::ios::ate);
+		CookedFormat::BlobHeader header;
+		if (!file || static_cast<size_t>(file.tellg()) < sizeof(header))
+		{
+			return false;
+		}
+
+		const size_t size = static_cast<size_t>(file.tellg());
+		file.seekg(0);
+		if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+		{
+			return false;
+		}
+
+		std::error_code error;
+		return std::memcmp(header.magic, CookedFormat::BLOB_MAGIC, sizeof(header.magic)) == 0 &&
+			header.version == CookedFormat::VERSION && header.source_hash == hash &&
+			size == sizeof(header) + size_t(header.width) * header.height * sizeof(uint32_t) &&
+			fs::exists(shellOf(blob), error);
+	}
+
+	bool cook(const fs::path& source, const fs::path& blob, uint64_t hash)
+	{
+		int width = 0, height = 0;
+		std::vector<uint32_t> pixels;
+		if (!ASGE::SWTextureCache::decode(source.string(), width, height, pixels))
+		{
+			std::fprintf(stderr, "TextureCooker: cannot decode %s\n", source.string().c_str());
+			return false;
+		}
+
+		CookedFormat::BlobHeader header{};
+		std::memcpy(header.magic, CookedFormat::BLOB_MAGIC, sizeof(header.magic));
+		header.version = CookedFormat::VERSION;
+		header.width = static_cast<uint32_t>(width);
+		header.height = static_cast<uint32_t>(height);
+		header.source_hash = hash;
+
+		std::ofstream file(blob, std::ios::binary);
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(pixels.data()), pixels.size() * sizeof(uint32_t));
+		if (!file)
+		{
+			std::fprintf(stderr, "TextureCooker: failed to write %s\n", blob.string().c_str());
+			return false;
+		}
+
+		return writeShell(shellOf(blob), width, height);
+	}
+
+	bool writeIndex(const fs::path& output, const std::vector<Image>& images)
+	{
+		std::vector<CookedFormat::IndexEntry> entries;
+		std::string strings;
+		for (const Image& image : images)
+		{
+			CookedFormat::IndexEntry entry{};
+			entry.path = static_cast<uint32_t>(strings.size());
+			entry.source_hash = image.hash;
+			entries.push_back(entry);
+			strings.append(image.path);
+			strings.push_back('\0');
+		}
+
+		CookedFormat::IndexHeader header{};
+		std::memcpy(header.magic, CookedFormat::INDEX_MAGIC, sizeof(header.magic));
+		header.version = CookedFormat::VERSION;
+		header.entry_count = static_cast<uint32_t>(entries.size());
+		header.string_bytes = static_cast<uint32_t>(strings.size());
+
+		std::ofstream file(output / CookedFormat::INDEX_FILE, std::ios::binary);
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(entries.data()),
+			entries.size() * sizeof(CookedFormat::IndexEntry));
+		file.write(strings.data(), strings.size());
+		if (!file)
+		{
+			std::fprintf(stderr, "TextureCooker: failed to write the index\n");
+			return false;
+		}
+
+		return true;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	fs::path output;
+	fs::path root = ".";
+	std::vector<std::string> inputs;
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+		{
+			output = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+		{
+			root = argv[++i];
+		}
+		else
+		{
+			inputs.push_back(argv[i]);
+		}
+	}
+
+	if (output.empty() || inputs.empty())
+	{
+		std::fprintf(stderr, "usage: TextureCooker -o output directory -r root paths...\n");
+		return 1;
+	}
+
+	//expand directories into the pngs they hold
+	std::vector<Image> images;
+	for (const auto& input : inputs)
+	{
+		std::error_code error;
+		if (!fs::is_directory(root / input, error))
+		{
+			images.push_back(Image{ input });
+			continue;
+		}
+
+		std::vector<std::string> found;
+		for (const auto& file : fs::directory_iterator(root / input, error))
+		{
+			if (file.path().extension() == ".png")
+			{
+				found.push_back((fs::path(input) / file.path().filename()).generic_string());
+			}
+		}
+
+		std::sort(found.begin(), found.end());
+		for (const auto& path : found)
+		{
+			images.push_back(Image{ path });
+		}
+	}
+
+	std::error_code error;
+	fs::create_directories(output, error);
+
+	size_t cooked = 0;
+	size_t kept = 0;
+	std::set<std::string> blobs;
+	for (Image& image : images)
+	{
+		const fs::path source = root / image.path;
+		if (!hashFile(source, image.hash))
+		{
+			std::fprintf(stderr, "TextureCooker: cannot read %s\n", source.string().c_str());
+			return 1;
+		}
+
+		const std::string name = blobName(image.hash);
+		if (!blobs.insert(name).second || blobIsCurrent(output / name, image.hash))
+		{
+			kept++;
+			continue;
+		}
+
+		if (!cook(source, output / name, image.hash))
+		{
+			return 1;
+		}
+
+		cooked++;
+	}
+
+	if (!writeIndex(output, images))
+	{
+		return 1;
+	}
+
+	//drop blobs and shells of images that have since changed
+	std::vector<fs::path> stale;
+	for (const auto& file : fs::directory_iterator(output, error))
+	{
+		const fs::path extension = file.path().extension();
+		if ((extension == ".tex" || extension == ".png") &&
+			!blobs.count(fs::path(file.path()).replace_extension(".tex").filename().string()))
+		{
+			stale.push_back(file.path());
+		}
+	}
+
+	for (const auto& blob : stale)
+	{
+		fs::remove(blob, error);
+	}
+
+	std::printf("TextureCooker: %zu images, %zu cooked, %zu unchanged, %zu stale files removed\n",
+		images.size(), cooked, kept, stale.size());
+	return 0;
+}